@@ -0,0 +1,391 @@
+// Microbenchmarks of the core kernels on a synthetic instance.
+//
+// Build from the repository root (every module except main.cpp):
+//   g++ -std=c++17 -O2 -pthread -I. bench/bench.cpp $(ls *.cpp | grep -v '^main.cpp$') -o bench_kernels
+// or run bench/build.sh.
+//
+// Real instances can be loaded with --instance (e.g. one written by generate_instance)
+//
+// Usage: bench_kernels [--instance FILE] [--ops N] [--machines M] [--jobs J] [--population P] [--repetitions R]
+//                      [--min-time MS] [--seed S] [--kernels a,b,...] [--format csv|json] [--output FILE]
+
+#include "headers/binary_instance.h"
+#include "headers/energy_batch.h"
+#include "headers/individual.h"
+#include "headers/instance_generator.h"
+#include "headers/island.h"
+#include "headers/nsgaII.h"
+#include "headers/policies.h"
+#include "headers/population.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct BenchConfig{
+    int num_ops       = 1000;
+    int num_machines  = 10;
+    int num_jobs      = 100;
+    int population    = 100;  // Individuals of the sorting, crowding and crossover kernels
+    int repetitions   = 15;
+    double min_time_ms = 20.0; // Every repetition runs the kernel at least this long
+    unsigned int seed = 42;
+    std::vector<std::string> kernels; // Empty = all of them
+    std::string format = "csv";
+    std::string output;               // Empty = stdout
+    std::string instance;             // Empty = synthetic instance
+};
+
+struct BenchResult{
+    std::string kernel;
+    long long iterations; // Calls per repetition
+    std::vector<double> ns_per_call;
+};
+
+// Keeps the optimizer from dropping the results of the kernels
+static volatile double sink = 0.0;
+
+static void printBenchUsage(const char* program){
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --instance FILE    benchmark a text or binary instance instead of a synthetic one\n"
+              << "  --ops N            operations of the synthetic instance (default 1000)\n"
+              << "  --machines M       machines (default 10)\n"
+              << "  --jobs J           jobs, the operations are split evenly (default 100)\n"
+              << "  --population P     individuals for sorting, crowding and crossover (default 100)\n"
+              << "  --repetitions R    timed repetitions of every kernel (default 15)\n"
+              << "  --min-time MS      minimum time of one repetition (default 20)\n"
+              << "  --seed S           seed of the instance and the chromosomes (default 42)\n"
+              << "  --kernels A,B,...  only these kernels (default all)\n"
+              << "  --format FMT       csv | json (default csv)\n"
+              << "  --output FILE      write the results to FILE instead of stdout\n";
+}
+
+static bool parseBenchArguments(int argc, char* argv[], BenchConfig& config){
+    for(int i = 1; i < argc; ++i){
+        std::string arg = argv[i];
+        if(arg == "--help" || arg == "-h"){
+            printBenchUsage(argv[0]);
+            return false;
+        }
+        if(i + 1 >= argc){
+            std::cerr << "Missing value for " << arg << "\n";
+            return false;
+        }
+        std::string value = argv[++i];
+
+        try{
+            if(arg == "--ops") config.num_ops = std::stoi(value);
+            else if(arg == "--machines") config.num_machines = std::stoi(value);
+            else if(arg == "--jobs") config.num_jobs = std::stoi(value);
+            else if(arg == "--population") config.population = std::stoi(value);
+            else if(arg == "--repetitions") config.repetitions = std::stoi(value);
+            else if(arg == "--min-time") config.min_time_ms = std::stod(value);
+            else if(arg == "--seed") config.seed = std::stoul(value);
+            else if(arg == "--format") config.format = value;
+            else if(arg == "--output") config.output = value;
+            else if(arg == "--instance") config.instance = value;
+            else if(arg == "--kernels"){
+                std::stringstream ss(value);
+                std::string name;
+                while(std::getline(ss, name, ',')) if(!name.empty()) config.kernels.push_back(name);
+            }else{
+                std::cerr << "Unknown option: " << arg << "\n";
+                return false;
+            }
+        }catch(const std::exception&){
+            std::cerr << "Invalid value for " << arg << ": " << value << "\n";
+            return false;
+        }
+    }
+
+    if(config.num_ops < 2 || config.num_machines < 1 || config.num_jobs < 1 || config.num_jobs > config.num_ops ||
+       config.population < 4 || config.repetitions < 1 || config.min_time_ms <= 0){
+        std::cerr << "Invalid instance or benchmark size\n";
+        return false;
+    }
+    if(config.format != "csv" && config.format != "json"){
+        std::cerr << "Unknown format: " << config.format << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Default generator instance: every operation in one job, jobs of the same length
+static void syntheticInstance(const BenchConfig& config, Data& data, vvi& jobs){
+    GeneratorParams params;
+    params.seed       = config.seed;
+    params.operations = config.num_ops;
+    params.machines   = config.num_machines;
+    params.jobs       = config.num_jobs;
+
+    vvf time, energy;
+    generateInstance(params, time, energy, jobs);
+    data.loadInstance(time, energy, jobs);
+}
+
+// Calls per repetition are doubled until a repetition takes min_time_ms, then one
+// warm-up repetition and the timed ones
+static BenchResult measure(const std::string& name, const std::function<void()>& kernel, const BenchConfig& config){
+    using clock = std::chrono::steady_clock;
+    auto run = [&kernel](long long iterations){
+        auto start = clock::now();
+        for(long long i = 0; i < iterations; ++i) kernel();
+        return std::chrono::duration<double, std::nano>(clock::now() - start).count();
+    };
+
+    long long iterations = 1;
+    while(run(iterations) < config.min_time_ms * 1e6 && iterations < (1LL << 40)) iterations *= 2;
+    run(iterations);
+
+    BenchResult result{name, iterations, {}};
+    for(int r = 0; r < config.repetitions; ++r){
+        result.ns_per_call.push_back(run(iterations) / iterations);
+    }
+    return result;
+}
+
+struct Summary{
+    double min, median, mean, stddev;
+};
+
+static Summary summarize(std::vector<double> values){
+    std::sort(values.begin(), values.end());
+    Summary s;
+    s.min    = values.front();
+    s.median = values.size() % 2 ? values[values.size() / 2]
+                                 : (values[values.size() / 2 - 1] + values[values.size() / 2]) / 2.0;
+    s.mean   = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    double sq = 0.0;
+    for(double v : values) sq += (v - s.mean) * (v - s.mean);
+    s.stddev = std::sqrt(sq / values.size());
+    return s;
+}
+
+static void writeResults(std::ostream& out, const std::vector<BenchResult>& results, const BenchConfig& config){
+    if(config.format == "json"){
+        out << "{\n  \"ops\": " << config.num_ops << ", \"machines\": " << config.num_machines
+            << ", \"jobs\": " << config.num_jobs << ", \"population\": " << config.population
+            << ", \"repetitions\": " << config.repetitions << ",\n  \"results\": [\n";
+        for(size_t i = 0; i < results.size(); ++i){
+            Summary s = summarize(results[i].ns_per_call);
+            out << "    {\"kernel\": \"" << results[i].kernel << "\", \"iterations\": " << results[i].iterations
+                << ", \"min_ns\": " << s.min << ", \"median_ns\": " << s.median
+                << ", \"mean_ns\": " << s.mean << ", \"stddev_ns\": " << s.stddev << "}"
+                << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+        return;
+    }
+
+    out << "Kernel,Ops,Machines,Jobs,Population,Repetitions,Iterations,Min_ns,Median_ns,Mean_ns,Stddev_ns\n";
+    for(const BenchResult& result : results){
+        Summary s = summarize(result.ns_per_call);
+        out << result.kernel << "," << config.num_ops << "," << config.num_machines << "," << config.num_jobs << ","
+            << config.population << "," << config.repetitions << "," << result.iterations << ","
+            << s.min << "," << s.median << "," << s.mean << "," << s.stddev << "\n";
+    }
+}
+
+int main(int argc, char* argv[]){
+    BenchConfig config;
+    if(!parseBenchArguments(argc, argv, config)) return 1;
+
+    Data data;
+    vvi jobs;
+    if(config.instance.empty()){
+        syntheticInstance(config, data, jobs);
+    }else{
+        if(!openInstance(config.instance, data, jobs, false)) return 1;
+        config.num_ops      = data.getNumTasks();
+        config.num_machines = data.getNumMachines();
+        config.num_jobs     = data.getNumJobs();
+    }
+    const int tasks = data.getNumTasks();
+    const int size  = config.population;
+
+    std::mt19937 gen(config.seed);
+    std::unordered_map<PolicyType, vec_op> policies_order = {
+        {PolicyType::FIFO,    FIFO(tasks, jobs)},
+        {PolicyType::LTP,     LTP(tasks, jobs, data)},
+        {PolicyType::STP,     STP(tasks, jobs, data)},
+        {PolicyType::RR_FIFO, RR_FIFO(tasks, jobs)},
+        {PolicyType::RR_LTP,  RR_LTP(tasks, jobs, data)},
+        {PolicyType::RR_ECA,  RR_ECA(tasks, jobs, data)},
+    };
+    const SchedulePlan plan(data, policies_order, static_cast<size_t>(RunConfig().plan_cost_mb) << 20);
+    const PolicyPlan& fifo = plan[PolicyType::FIFO];
+
+    // Parents with random chromosomes and fitness, room for a whole offspring population
+    GeneArena arena(tasks, NUM_POLICIES * (2 * size + 2)); // + the two children of the mutation check
+    Population parents(size);
+    Population offspring(size);
+    parents.resize(size);
+    offspring.resize(size);
+    std::uniform_int_distribution<> machine(0, config.num_machines - 1);
+    std::uniform_real_distribution<float> objective(0.0f, 1000.0f);
+    for(int p = 0; p < NUM_POLICIES; ++p){
+        PolicyType policy = static_cast<PolicyType>(p);
+        for(int ind = 0; ind < size; ++ind){
+            int row = arena.acquire();
+            for(int i = 0; i < tasks; ++i) arena.row(row)[i] = machine(gen);
+            parents.row(policy, ind) = row;
+            parents.times(policy)[ind]    = objective(gen);
+            parents.energies(policy)[ind] = objective(gen);
+        }
+    }
+    std::vector<IndividualDelta> deltas(size);
+    std::vector<char> swap_mask;
+    for(int ind = 0; ind + 1 < size; ind += 2){
+        arena.acquireIndividual(offspring, ind);
+        arena.acquireIndividual(offspring, ind + 1);
+        crossover(parents, ind, ind + 1, offspring, ind, ind + 1, arena, gen, 50, deltas[ind], deltas[ind + 1], swap_mask);
+    }
+
+    const int* chromosome = arena.row(parents.row(PolicyType::FIFO, 0));
+    EvalScratch scratch;
+    std::vector<int> shuffled_front(size);
+    std::iota(shuffled_front.begin(), shuffled_front.end(), 0);
+    std::shuffle(shuffled_front.begin(), shuffled_front.end(), gen);
+    std::vector<int> front;
+    FrontSet fronts; // Reused like in a run, the sorts and the crowding distance don't allocate
+
+    // The FIFO chromosomes of the whole population. Every level the CPU runs must give the
+    // bits of the scalar loop
+    std::vector<const int*> batch(size);
+    for(int ind = 0; ind < size; ++ind) batch[ind] = arena.row(parents.row(PolicyType::FIFO, ind));
+    std::vector<float> batch_energy(size);
+    // Also on a plan that reads the instance rows, the one of an instance beyond --plan-mb
+    const SchedulePlan unordered_plan(data, policies_order, 0);
+    for(const PolicyPlan* checked : {&fifo, &unordered_plan[PolicyType::FIFO]}){
+        for(SimdLevel level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}){
+            totalEnergyBatch(*checked, batch.data(), size, batch_energy.data(), level);
+            for(int ind = 0; ind < size; ++ind){
+                if(batch_energy[ind] != totalEnergy(*checked, batch[ind])){
+                    std::cerr << "totalEnergyBatch (" << simdLevelName(level) << ") differs from totalEnergy\n";
+                    return 1;
+                }
+            }
+        }
+    }
+    std::cerr << "Batch kernels: " << simdLevelName(detectSimdLevel()) << "\n";
+
+    // The two children of a pair mutate from their own streams: identical children given the
+    // same mutation end up different
+    {
+        Population twins(2);
+        twins.resize(2);
+        for(int child = 0; child < 2; ++child){
+            arena.acquireIndividual(twins, child);
+            for(int p = 0; p < NUM_POLICIES; ++p){
+                PolicyType policy = static_cast<PolicyType>(p);
+                const int* genes = arena.row(parents.row(policy, 0));
+                std::copy(genes, genes + tasks, arena.row(twins.row(policy, child)));
+            }
+        }
+        RngStream pair_stream(config.seed, 0, 1, RngPhase::VARIATION, 0);
+        for(int child = 0; child < 2; ++child){
+            RngStream child_stream = childGenerator(pair_stream, child);
+            IndividualDelta delta;
+            equitativeExchange(twins, child, arena, child_stream, delta);
+            circular(twins, child, arena, child_stream, delta);
+        }
+        bool different = false;
+        for(int p = 0; p < NUM_POLICIES; ++p){
+            PolicyType policy = static_cast<PolicyType>(p);
+            different = different || !std::equal(arena.row(twins.row(policy, 0)), arena.row(twins.row(policy, 0)) + tasks,
+                                                 arena.row(twins.row(policy, 1)));
+        }
+        if(!different){
+            std::cerr << "The children of a pair got the same mutations\n";
+            return 1;
+        }
+    }
+
+    std::vector<std::pair<std::string, std::function<void()>>> kernels = {
+        {"totalTime",      [&](){ sink = sink + totalTime(fifo, chromosome).first; }},
+        {"totalMakespan",  [&](){ sink = sink + totalMakespan(fifo, chromosome, scratch); }},
+        {"totalEnergy",    [&](){ sink = sink + totalEnergy(fifo, chromosome); }},
+        {"evaluate",       [&](){ sink = sink + evaluate(fifo, chromosome, scratch).makespan; }},
+        // The time is per batch of a whole population
+        {"totalEnergyBatch", [&](){
+            totalEnergyBatch(fifo, batch.data(), size, batch_energy.data());
+            sink = sink + batch_energy[0];
+        }},
+        {"totalEnergyBatchScalar", [&](){
+            totalEnergyBatch(fifo, batch.data(), size, batch_energy.data(), SimdLevel::SCALAR);
+            sink = sink + batch_energy[0];
+        }},
+        {"fastNonDominatedSort",  [&](){
+            fastNonDominatedSort(parents, PolicyType::FIFO, fronts);
+            sink = sink + fronts.numFronts();
+        }},
+        {"sweepNonDominatedSort", [&](){
+            sweepNonDominatedSort(parents, PolicyType::FIFO, fronts);
+            sink = sink + fronts.numFronts();
+        }},
+        // The whole population as a single front, the worst case
+        {"calculateCrowdingDistance", [&](){
+            front = shuffled_front;
+            calculateCrowdingDistance(parents, front.data(), size, PolicyType::FIFO, fronts.keys);
+            sink = sink + parents.crowding(PolicyType::FIFO)[front[size / 2]];
+        }},
+        // A whole offspring population per call is too coarse, the time is per crossover
+        {"crossover", [&](){
+            arena.collect(parents);
+            for(int ind = 0; ind + 1 < size; ind += 2){
+                arena.acquireIndividual(offspring, ind);
+                arena.acquireIndividual(offspring, ind + 1);
+                crossover(parents, ind, ind + 1, offspring, ind, ind + 1, arena, gen, 50, deltas[ind], deltas[ind + 1], swap_mask);
+            }
+        }},
+        {"equitativeExchange", [&](){ equitativeExchange(offspring, 0, arena, gen, deltas[0]); }},
+        {"interChrome",        [&](){ interChrome(offspring, 0, gen, deltas[0]); }},
+        {"circular",           [&](){ circular(offspring, 0, arena, gen, deltas[0]); }},
+        {"FIFO",    [&](){ sink = sink + FIFO(tasks, jobs).size(); }},
+        {"LTP",     [&](){ sink = sink + LTP(tasks, jobs, data).size(); }},
+        {"STP",     [&](){ sink = sink + STP(tasks, jobs, data).size(); }},
+        {"RR_FIFO", [&](){ sink = sink + RR_FIFO(tasks, jobs).size(); }},
+        {"RR_LTP",  [&](){ sink = sink + RR_LTP(tasks, jobs, data).size(); }},
+        {"RR_ECA",  [&](){ sink = sink + RR_ECA(tasks, jobs, data).size(); }},
+    };
+
+    for(const std::string& name : config.kernels){
+        bool known = std::any_of(kernels.begin(), kernels.end(), [&name](const auto& k){ return k.first == name; });
+        if(!known){
+            std::cerr << "Unknown kernel: " << name << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    for(const auto& [name, kernel] : kernels){
+        if(!config.kernels.empty() && std::find(config.kernels.begin(), config.kernels.end(), name) == config.kernels.end()) continue;
+        std::cerr << "Running " << name << "...\n";
+        BenchResult result = measure(name, kernel, config);
+        if(name == "crossover"){
+            int calls = size / 2;
+            for(double& ns : result.ns_per_call) ns /= calls;
+        }
+        results.push_back(result);
+    }
+
+    if(config.output.empty()){
+        writeResults(std::cout, results, config);
+        return 0;
+    }
+    std::ofstream file(config.output);
+    if(!file.is_open()){
+        std::cerr << "Could not open " << config.output << "\n";
+        return 1;
+    }
+    writeResults(file, results, config);
+    return 0;
+}
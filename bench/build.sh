@@ -0,0 +1,6 @@
+#!/bin/sh
+# Builds bench_kernels and generate_instance in the repository root, extra flags go to g++ (e.g. -march=native)
+cd "$(dirname "$0")/.." || exit 1
+MODULES=$(ls *.cpp | grep -v '^main.cpp$')
+g++ -std=c++17 -O2 -pthread -I. "$@" bench/bench.cpp $MODULES -o bench_kernels || exit 1
+g++ -std=c++17 -O2 -pthread -I. "$@" bench/generate_instance.cpp $MODULES -o generate_instance
@@ -0,0 +1,97 @@
+// Seeded synthetic instances in the text format of test/testcase_structure.txt.
+//
+// Build from the repository root (every module except main.cpp):
+//   g++ -std=c++17 -O2 -pthread -I. bench/generate_instance.cpp $(ls *.cpp | grep -v '^main.cpp$') -o generate_instance
+// or run bench/build.sh.
+//
+// Example, 10^5 operations over 20 heterogeneous machines with skewed jobs:
+//   ./generate_instance --operations 100000 --machines 20 --jobs 2000 --job-skew 1.0 --heterogeneity 0.5 -o test/Big.txt
+
+#include "headers/instance_generator.h"
+
+#include <iostream>
+#include <string>
+
+static void printGeneratorUsage(const char* program){
+    GeneratorParams defaults;
+    std::cout << "Usage: " << program << " [options] -o FILE\n"
+              << "  --seed S             seed of the instance (default " << defaults.seed << ")\n"
+              << "  --operations N       operations of all the jobs together (default " << defaults.operations << ")\n"
+              << "  --operation-types T  rows of the tables, 0 = one per operation (default 0)\n"
+              << "  --machines M         machines (default " << defaults.machines << ")\n"
+              << "  --jobs J             jobs (default " << defaults.jobs << ")\n"
+              << "  --time A,B           range of the mean time of an operation (default 1,10)\n"
+              << "  --energy A,B         range of the mean energy of an operation (default 1,10)\n"
+              << "  --correlation R      time/energy correlation of every entry, -1..1 (default 0)\n"
+              << "  --noise S            log-normal spread of the entries (default " << defaults.noise << ")\n"
+              << "  --job-skew Z         Zipf exponent of the job lengths, 0 = equal jobs (default 0)\n"
+              << "  --heterogeneity H    log-normal spread of the machine speed and power (default 0)\n"
+              << "  -o, --output FILE    instance file to write\n";
+}
+
+static bool parseRange(const std::string& text, float& low, float& high){
+    size_t comma = text.find(',');
+    if(comma == std::string::npos) return false;
+    low  = std::stof(text.substr(0, comma));
+    high = std::stof(text.substr(comma + 1));
+    return true;
+}
+
+int main(int argc, char* argv[]){
+    GeneratorParams params;
+    std::string output;
+
+    for(int i = 1; i < argc; ++i){
+        std::string arg = argv[i];
+        if(arg == "--help" || arg == "-h"){
+            printGeneratorUsage(argv[0]);
+            return 0;
+        }
+        if(i + 1 >= argc){
+            std::cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        bool valid = true;
+        try{
+            if(arg == "--seed") params.seed = std::stoull(value);
+            else if(arg == "--operations") params.operations = std::stoi(value);
+            else if(arg == "--operation-types") params.operation_types = std::stoi(value);
+            else if(arg == "--machines") params.machines = std::stoi(value);
+            else if(arg == "--jobs") params.jobs = std::stoi(value);
+            else if(arg == "--time") valid = parseRange(value, params.time_min, params.time_max);
+            else if(arg == "--energy") valid = parseRange(value, params.energy_min, params.energy_max);
+            else if(arg == "--correlation") params.correlation = std::stod(value);
+            else if(arg == "--noise") params.noise = std::stod(value);
+            else if(arg == "--job-skew") params.job_skew = std::stod(value);
+            else if(arg == "--heterogeneity") params.heterogeneity = std::stod(value);
+            else if(arg == "-o" || arg == "--output") output = value;
+            else{
+                std::cerr << "Unknown option: " << arg << "\n";
+                return 1;
+            }
+        }catch(const std::exception&){
+            valid = false;
+        }
+        if(!valid){
+            std::cerr << "Invalid value for " << arg << ": " << value << "\n";
+            return 1;
+        }
+    }
+
+    if(output.empty()){
+        printGeneratorUsage(argv[0]);
+        return 1;
+    }
+    if(!validateGeneratorParams(params)) return 1;
+
+    vvf time, energy;
+    vvi jobs;
+    generateInstance(params, time, energy, jobs);
+    if(!writeInstanceFile(output, time, energy, jobs)) return 1;
+
+    std::cout << output << ": " << params.operations << " operations, " << time.size() << " operation types, "
+              << params.machines << " machines, " << params.jobs << " jobs\n";
+    return 0;
+}
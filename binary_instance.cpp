@@ -0,0 +1,199 @@
+#include "headers/binary_instance.h"
+#include "headers/mapped_file.h"
+#include "headers/read_test.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+static const char BINARY_MAGIC[8] = {'P', 'G', 'A', 'I', 'N', 'S', 'T', '\0'};
+static const uint32_t BINARY_VERSION = 1;
+static const uint32_t BINARY_ENDIANNESS = 0x01020304;
+static const uint64_t SECTION_ALIGN = 64;
+
+static uint64_t alignSection(uint64_t offset){
+    return (offset + SECTION_ALIGN - 1) / SECTION_ALIGN * SECTION_ALIGN;
+}
+
+static bool hasMagic(const char* bytes, size_t size){
+    return size >= sizeof(BINARY_MAGIC) && std::memcmp(bytes, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+}
+
+// Written so that no sum or product can wrap around with a crafted header
+static bool sectionFits(uint64_t offset, uint64_t bytes, uint64_t file_size){
+    return offset <= file_size && bytes <= file_size - offset;
+}
+
+bool isBinaryInstance(const std::string& path){
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(BINARY_MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    return file && hasMagic(magic, sizeof(magic));
+}
+
+std::string binaryPathFor(const std::string& text_path){
+    return std::filesystem::path(text_path).replace_extension(".bin").string();
+}
+
+bool saveBinaryInstance(const std::string& path, const Data& data, const vvi& jobs){
+    BinaryInstanceHeader header{};
+    std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    header.version      = BINARY_VERSION;
+    header.endianness   = BINARY_ENDIANNESS;
+    header.num_rows     = data.getNumRows();
+    header.num_machines = data.getNumMachines();
+    header.row_stride   = data.getRowStride();
+    header.num_jobs     = jobs.size();
+    header.num_job_ops  = 0;
+    for(const auto& job : jobs) header.num_job_ops += job.size();
+
+    uint64_t table_bytes = static_cast<uint64_t>(header.num_rows) * header.row_stride * sizeof(float);
+    header.time_offset        = alignSection(sizeof(BinaryInstanceHeader));
+    header.energy_offset      = alignSection(header.time_offset + table_bytes);
+    header.job_offsets_offset = alignSection(header.energy_offset + table_bytes);
+    header.job_ops_offset     = alignSection(header.job_offsets_offset + (header.num_jobs + 1) * sizeof(uint32_t));
+    header.file_size          = header.job_ops_offset + header.num_job_ops * sizeof(uint32_t);
+
+    // CSR job list
+    std::vector<uint32_t> job_offsets(header.num_jobs + 1, 0);
+    std::vector<uint32_t> job_ops;
+    job_ops.reserve(header.num_job_ops);
+    for(size_t j = 0; j < jobs.size(); ++j){
+        for(int op : jobs[j]) job_ops.push_back(op);
+        job_offsets[j + 1] = job_ops.size();
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if(!file.is_open()){
+        std::cerr << "Error: Could'nt write the binary instance: " << path << "\n";
+        return false;
+    }
+
+    auto pad_to = [&file](uint64_t offset){
+        static const char zeros[SECTION_ALIGN] = {};
+        uint64_t position = file.tellp();
+        if(offset > position) file.write(zeros, offset - position);
+    };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    pad_to(header.time_offset);
+    // Rows are contiguous in Data, padding included
+    if(header.num_rows > 0){
+        file.write(reinterpret_cast<const char*>(data.timeRow(0)), table_bytes);
+        pad_to(header.energy_offset);
+        file.write(reinterpret_cast<const char*>(data.energyRow(0)), table_bytes);
+    }
+    pad_to(header.job_offsets_offset);
+    file.write(reinterpret_cast<const char*>(job_offsets.data()), job_offsets.size() * sizeof(uint32_t));
+    pad_to(header.job_ops_offset);
+    file.write(reinterpret_cast<const char*>(job_ops.data()), job_ops.size() * sizeof(uint32_t));
+
+    if(!file){
+        std::cerr << "Error: Could'nt write the binary instance: " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool loadBinaryInstance(const std::string& path, Data& data, vvi& jobs){
+    MappedFile file;
+    if(!file.open(path)){
+        std::cerr << "Test case file not found: " << path << "\n";
+        return false;
+    }
+
+    auto fail = [&path](const char* message){
+        std::cerr << path << ": " << message << "\n";
+        return false;
+    };
+
+    if(file.size() < sizeof(BinaryInstanceHeader) || !hasMagic(file.data(), file.size())){
+        return fail("not a binary instance");
+    }
+
+    BinaryInstanceHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if(header.endianness != BINARY_ENDIANNESS) return fail("binary instance written with a different endianness");
+    if(header.version != BINARY_VERSION) return fail("unsupported binary instance version");
+    if(header.file_size != file.size()) return fail("truncated or corrupted binary instance");
+    if(header.num_rows < 1 || header.num_machines < 1 || header.row_stride < header.num_machines){
+        return fail("invalid table size in binary instance");
+    }
+
+    if(header.row_stride > header.file_size / sizeof(float) / header.num_rows){
+        return fail("section out of bounds in binary instance");
+    }
+    uint64_t table_bytes = static_cast<uint64_t>(header.num_rows) * header.row_stride * sizeof(float);
+    if(!sectionFits(header.time_offset, table_bytes, header.file_size) ||
+       !sectionFits(header.energy_offset, table_bytes, header.file_size) ||
+       !sectionFits(header.job_offsets_offset, (static_cast<uint64_t>(header.num_jobs) + 1) * sizeof(uint32_t), header.file_size) ||
+       !sectionFits(header.job_ops_offset, static_cast<uint64_t>(header.num_job_ops) * sizeof(uint32_t), header.file_size)){
+        return fail("section out of bounds in binary instance");
+    }
+
+    // Tables, one block copy when the padding matches the one of this build
+    const float* time   = reinterpret_cast<const float*>(file.data() + header.time_offset);
+    const float* energy = reinterpret_cast<const float*>(file.data() + header.energy_offset);
+    data.allocateTables(header.num_rows, header.num_machines);
+    if(static_cast<uint32_t>(data.getRowStride()) == header.row_stride){
+        std::memcpy(data.mutableTimeRow(0), time, table_bytes);
+        std::memcpy(data.mutableEnergyRow(0), energy, table_bytes);
+    }else{
+        for(uint32_t op = 0; op < header.num_rows; ++op){
+            size_t row = static_cast<size_t>(op) * header.row_stride;
+            std::memcpy(data.mutableTimeRow(op), time + row, header.num_machines * sizeof(float));
+            std::memcpy(data.mutableEnergyRow(op), energy + row, header.num_machines * sizeof(float));
+        }
+    }
+
+    // Jobs
+    const uint32_t* job_offsets = reinterpret_cast<const uint32_t*>(file.data() + header.job_offsets_offset);
+    const uint32_t* job_ops     = reinterpret_cast<const uint32_t*>(file.data() + header.job_ops_offset);
+    if(job_offsets[header.num_jobs] != header.num_job_ops) return fail("invalid job list in binary instance");
+
+    jobs.assign(header.num_jobs, {});
+    for(uint32_t j = 0; j < header.num_jobs; ++j){
+        if(job_offsets[j] > job_offsets[j + 1] || job_offsets[j + 1] > header.num_job_ops){
+            return fail("invalid job list in binary instance");
+        }
+        jobs[j].assign(job_ops + job_offsets[j], job_ops + job_offsets[j + 1]);
+        for(int op : jobs[j]){
+            if(op < 1 || op > static_cast<int>(header.num_rows)) return fail("operation out of range in binary instance");
+        }
+    }
+
+    data.finishLoading(jobs);
+    return true;
+}
+
+bool convertToBinary(const std::string& text_path, const std::string& binary_path){
+    Data data;
+    vvi jobs;
+    if(!loadInstanceFile(text_path, data, jobs)) return false;
+    return saveBinaryInstance(binary_path, data, jobs);
+}
+
+// The cached copy is only trusted if it's newer than the text instance
+static bool cacheUpToDate(const std::string& text_path, const std::string& binary_path){
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    if(!fs::exists(binary_path, ec)) return false;
+    auto text_time   = fs::last_write_time(text_path, ec);
+    if(ec) return false;
+    auto binary_time = fs::last_write_time(binary_path, ec);
+    return !ec && binary_time >= text_time && isBinaryInstance(binary_path);
+}
+
+bool openInstance(const std::string& path, Data& data, vvi& jobs, bool use_cache){
+    if(isBinaryInstance(path)) return loadBinaryInstance(path, data, jobs);
+    if(!use_cache) return loadInstanceFile(path, data, jobs);
+
+    std::string binary_path = binaryPathFor(path);
+    if(cacheUpToDate(path, binary_path) && loadBinaryInstance(binary_path, data, jobs)) return true;
+
+    if(!loadInstanceFile(path, data, jobs)) return false;
+    // A failed cache write only costs the parse next time
+    saveBinaryInstance(binary_path, data, jobs);
+    return true;
+}
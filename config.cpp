@@ -0,0 +1,255 @@
+#include "headers/config.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+static std::string trim(const std::string& text){
+    size_t first = text.find_first_not_of(" \t\r");
+    if(first == std::string::npos) return "";
+    size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+// Comma (or space) separated list
+static std::vector<std::string> splitList(const std::string& text){
+    std::vector<std::string> items;
+    std::string normalized = text;
+    for(char& c : normalized) if(c == ',') c = ' ';
+
+    std::stringstream ss(normalized);
+    std::string item;
+    while(ss >> item) items.push_back(item);
+    return items;
+}
+
+static bool parseBool(const std::string& text, bool& out){
+    if(text == "on" || text == "true" || text == "1" || text == "yes"){
+        out = true;
+        return true;
+    }
+    if(text == "off" || text == "false" || text == "0" || text == "no"){
+        out = false;
+        return true;
+    }
+    return false;
+}
+
+static bool parseInt(const std::string& text, int min_value, int& out){
+    try{
+        size_t used = 0;
+        int value = std::stoi(text, &used);
+        if(used != text.size() || value < min_value) return false;
+        out = value;
+        return true;
+    }catch(const std::exception&){
+        return false;
+    }
+}
+
+// One option, shared by the command line and the config file
+static bool applyOption(const std::string& key, const std::string& value, RunConfig& config){
+    int number = 0;
+
+    if(key == "population"){
+        if(!parseInt(value, 2, number)) return false; // The tournament needs two candidates
+        config.population_size = number;
+    }else if(key == "generations"){
+        if(!parseInt(value, 1, number)) return false;
+        config.generation_size = number;
+    }else if(key == "checkpoint"){
+        if(!parseInt(value, 1, number)) return false;
+        config.checkpoint_interval = number;
+    }else if(key == "threads"){
+        if(!parseInt(value, 0, number)) return false;
+        config.num_threads = number;
+    }else if(key == "parallel-generation"){
+        return parseBool(value, config.parallel_generation);
+    }else if(key == "seeds"){
+        std::vector<int> seeds;
+        for(const std::string& item : splitList(value)){
+            if(!parseInt(item, 0, number)) return false;
+            seeds.push_back(number);
+        }
+        if(seeds.empty()) return false;
+        config.seeds = seeds;
+    }else if(key == "instances"){
+        std::vector<std::string> instances = splitList(value);
+        if(instances.empty()) return false;
+        config.instances = instances;
+    }else if(key == "output"){
+        if(value.empty()) return false;
+        config.output_dir = value;
+    }else if(key == "sort"){
+        if(value == "reference") config.sort_method = SortMethod::REFERENCE;
+        else if(value == "sweep") config.sort_method = SortMethod::SWEEP;
+        else return false;
+    }else if(key == "gantt"){
+        if(value == "files") config.gantt_output = GanttOutput::FILES;
+        else if(value == "packed") config.gantt_output = GanttOutput::PACKED;
+        else if(value == "none") config.gantt_output = GanttOutput::NONE;
+        else return false;
+    }else if(key == "gantt-queue"){
+        if(!parseInt(value, 1, number)) return false;
+        config.gantt_queue = number;
+    }else if(key == "engine"){
+        if(value == "generational") config.engine = Engine::GENERATIONAL;
+        else if(value == "steady") config.engine = Engine::STEADY_STATE;
+        else if(value == "island") config.engine = Engine::ISLAND;
+        else return false;
+    }else if(key == "islands"){
+        if(!parseInt(value, 1, number)) return false;
+        config.num_islands = number;
+    }else if(key == "migration-interval"){
+        if(!parseInt(value, 1, number)) return false;
+        config.migration_interval = number;
+    }else if(key == "migration-size"){
+        if(!parseInt(value, 0, number)) return false;
+        config.migration_size = number;
+    }else if(key == "topology"){
+        if(value == "ring") config.topology = Topology::RING;
+        else if(value == "all") config.topology = Topology::ALL;
+        else return false;
+    }else if(key == "rng"){
+        if(value == "mt19937") config.rng_mode = RngMode::MT19937;
+        else if(value == "streams") config.rng_mode = RngMode::STREAMS;
+        else return false;
+    }else if(key == "delta"){
+        return parseBool(value, config.incremental_eval);
+    }else if(key == "fitness-cache"){
+        if(!parseInt(value, 0, number)) return false;
+        config.fitness_cache_mb = number;
+    }else if(key == "plan-mb"){
+        if(!parseInt(value, 0, number)) return false;
+        config.plan_cost_mb = number;
+    }else if(key == "profile"){
+        return parseBool(value, config.write_profile);
+    }else if(key == "cache"){
+        return parseBool(value, config.binary_cache);
+    }else if(key == "convert"){
+        return parseBool(value, config.convert_only);
+    }else{
+        return false; // Unknown option
+    }
+    return true;
+}
+
+bool loadConfigFile(const std::string& path, RunConfig& config){
+    std::ifstream file(path);
+    if(!file.is_open()){
+        std::cerr << "Config file not found: " << path << "\n";
+        return false;
+    }
+
+    std::string line;
+    int line_number = 0;
+    while(std::getline(file, line)){
+        ++line_number;
+        size_t comment = line.find('#');
+        if(comment != std::string::npos) line.erase(comment);
+        line = trim(line);
+        if(line.empty()) continue;
+
+        size_t eq = line.find('=');
+        if(eq == std::string::npos){
+            std::cerr << path << ":" << line_number << ": expected 'key = value'\n";
+            return false;
+        }
+
+        std::string key   = trim(line.substr(0, eq));
+        std::string value = trim(line.substr(eq + 1));
+        if(!applyOption(key, value, config)){
+            std::cerr << path << ":" << line_number << ": unknown option or invalid value '" << key << " = " << value << "'\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+void printUsage(const char* program){
+    std::cout << "Usage: " << program << " [options] [instance files...]\n"
+              << "  --config FILE        read options from FILE (key = value)\n"
+              << "  --population N       individuals per population (default 10)\n"
+              << "  --generations N      generations per seed (default 100)\n"
+              << "  --seeds A,B,...      seeds to run (default: the 30 of the experiment)\n"
+              << "  --instances A,B,...  instance files (default test/Eg1.txt,test/Eg2.txt,test/Eg3.txt)\n"
+              << "  --checkpoint N       log the Pareto fronts every N generations (default 20)\n"
+              << "  --output DIR         output directory (default results)\n"
+              << "  --threads N          seeds run concurrently, 0 = every core (default 0)\n"
+              << "  --parallel-generation on|off  evaluate and sort inside a generation on the threads too (default on)\n"
+              << "  --sort METHOD        reference | sweep (default reference)\n"
+              << "  --gantt MODE         files | packed | none (default files)\n"
+              << "  --gantt-queue N      seeds waiting for the Gantt export thread (default 2)\n"
+              << "  --engine ENGINE      generational | steady | island (default generational)\n"
+              << "  --islands N          islands of the island engine (default 4)\n"
+              << "  --migration-interval N  generations between migrations (default 10)\n"
+              << "  --migration-size N   migrants per policy sent to each neighbour (default 2)\n"
+              << "  --topology T         ring | all, where the migrants go (default ring)\n"
+              << "  --rng MODE           mt19937 | streams, random numbers of the operators (default mt19937)\n"
+              << "  --delta on|off       re-evaluate offspring from their first changed gene (default on)\n"
+              << "  --fitness-cache MB   memo of evaluated chromosomes, 0 = off (default 0)\n"
+              << "  --plan-mb MB         costs copied in priority order for the evaluators, 0 = off (default 256)\n"
+              << "  --profile on|off     write the time of every phase by seed to profile.csv (default off)\n"
+              << "  --cache on|off       reuse a binary copy (.bin) of text instances (default off)\n"
+              << "  --convert on|off     only convert the instances to binary (.bin) and exit\n"
+              << "  --help               show this message\n";
+}
+
+bool parseArguments(int argc, char* argv[], RunConfig& config){
+    // The config file goes first so the command line can override it
+    for(int i = 1; i < argc; ++i){
+        std::string arg = argv[i];
+        if(arg == "--config"){
+            if(i + 1 >= argc){
+                std::cerr << "Missing value for --config\n";
+                return false;
+            }
+            if(!loadConfigFile(argv[++i], config)) return false;
+        }
+    }
+
+    std::vector<std::string> positional;
+    for(int i = 1; i < argc; ++i){
+        std::string arg = argv[i];
+        if(arg == "--help" || arg == "-h"){
+            config.show_help = true;
+            return true;
+        }
+        if(arg == "--config"){
+            ++i;
+            continue;
+        }
+        if(arg.rfind("--", 0) != 0){
+            positional.push_back(arg);
+            continue;
+        }
+
+        // Both "--key value" and "--key=value"
+        std::string key = arg.substr(2);
+        std::string value;
+        size_t eq = key.find('=');
+        if(eq != std::string::npos){
+            value = key.substr(eq + 1);
+            key.erase(eq);
+        }else if(i + 1 < argc){
+            value = argv[++i];
+        }else{
+            std::cerr << "Missing value for " << arg << "\n";
+            return false;
+        }
+
+        if(!applyOption(key, value, config)){
+            std::cerr << "Unknown option or invalid value: --" << key << " " << value << "\n";
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+
+    if(!positional.empty()) config.instances = positional;
+    return true;
+}
+
+std::string instanceName(const std::string& path){
+    return std::filesystem::path(path).stem().string();
+}
@@ -1,21 +1,75 @@
 #include "headers/individual.h"
 
+#include <algorithm>
+
 // Empty constructor
-Data::Data() : num_machines(0), total_operations(0) {}
+Data::Data() : num_machines(0), total_operations(0), total_jobs(0), num_rows(0), row_stride(0), col_stride(0) {}
+
+static int padToSimd(int n){
+    return (n + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+}
 
 bool Data::loadInstance(const vvf& time, const vvf& energy, const vvi& jobs){
     if(time.empty() || energy.empty()) return false;
     
-    task_energy = energy;
-    task_time = time;
-    
-    num_machines = time[0].size(); // Could be energy[0].size(), they have the same size
+    allocateTables(time.size(), time[0].size()); // Could be energy[0].size(), they have the same size
+
+    for(int op = 0; op < num_rows; ++op){
+        std::copy(time[op].begin(), time[op].begin() + num_machines, mutableTimeRow(op));
+        std::copy(energy[op].begin(), energy[op].begin() + num_machines, mutableEnergyRow(op));
+    }
+
+    finishLoading(jobs);
+    return true;
+}
+
+void Data::allocateTables(int rows, int machines){
+    num_rows = rows;
+    num_machines = machines;
+    row_stride = padToSimd(num_machines);
+
+    task_time.assign(static_cast<size_t>(num_rows) * row_stride, 0.0f);
+    task_energy.assign(static_cast<size_t>(num_rows) * row_stride, 0.0f);
+
+    // Stale copies from a previous instance
+    col_stride = 0;
+    machine_time.clear();
+    machine_energy.clear();
+}
+
+float* Data::mutableTimeRow(int task){
+    return task_time.data() + task * row_stride;
+}
+
+float* Data::mutableEnergyRow(int task){
+    return task_energy.data() + task * row_stride;
+}
+
+void Data::finishLoading(const vvi& jobs){
     total_jobs = jobs.size();
     total_operations = 0;
     
     for(const auto& work : jobs) total_operations += work.size();
-    
-    return true;
+
+    task_time_energy.resize(static_cast<size_t>(num_rows) * num_machines);
+    for(int op = 0; op < num_rows; ++op){
+        for(int machine = 0; machine < num_machines; ++machine){
+            task_time_energy[op * num_machines + machine] = {getTime(op, machine), getEnergy(op, machine)};
+        }
+    }
+}
+
+void Data::buildMachineMajor(){
+    col_stride = padToSimd(num_rows);
+    machine_time.assign(static_cast<size_t>(num_machines) * col_stride, 0.0f);
+    machine_energy.assign(static_cast<size_t>(num_machines) * col_stride, 0.0f);
+
+    for(int op = 0; op < num_rows; ++op){
+        for(int machine = 0; machine < num_machines; ++machine){
+            machine_time[machine * col_stride + op]   = task_time[op * row_stride + machine];
+            machine_energy[machine * col_stride + op] = task_energy[op * row_stride + machine];
+        }
+    }
 }
 
 
@@ -31,12 +85,14 @@ int Data::getNumJobs() const{
     return total_jobs;
 }
 
-// Operation and Machine in the table
-float Data::getTime(int task, int machine) const{ 
-    return task_time[task][machine];
+int Data::getNumRows() const{
+    return num_rows;
 }
 
-// Operation and Machine in the table
-float Data::getEnergy(int task, int machine) const{
-    return task_energy[task][machine];
-}
\ No newline at end of file
+int Data::getRowStride() const{
+    return row_stride;
+}
+
+bool Data::hasMachineMajor() const{
+    return !machine_time.empty();
+}
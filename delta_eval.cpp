@@ -0,0 +1,157 @@
+#include "headers/delta_eval.h"
+#include "headers/fitness_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Saving a state costs about as much as replaying that many priorities, so states
+// are never closer than the size of a state
+static const int MIN_STRIDE = 16;
+
+PrefixCache::PrefixCache(const SchedulePlan& plan, int max_rows, int num_lanes)
+    : num_ops(plan[0].num_ops), num_jobs(plan[0].num_jobs), num_machines(plan[0].num_machines){
+    stride     = std::max(MIN_STRIDE, num_jobs + num_machines);
+    num_states = std::max(1, (num_ops + stride - 1) / stride);
+    state_size = num_jobs + num_machines + 1;
+
+    states.assign(static_cast<size_t>(max_rows) * num_states * state_size, 0.0f);
+    final_fitness.assign(max_rows, {0.0f, 0.0f});
+    row_plan.assign(max_rows, nullptr);
+    row_states.assign(max_rows, 0);
+    lanes.resize(num_lanes);
+    for(Lane& lane : lanes) lane.work.assign(state_size, 0.0f);
+}
+
+long long PrefixCache::replayedOps() const{
+    long long total = 0;
+    for(const Lane& lane : lanes) total += lane.replayed_ops;
+    return total;
+}
+
+long long PrefixCache::requestedOps() const{
+    long long total = 0;
+    for(const Lane& lane : lanes) total += lane.requested_ops;
+    return total;
+}
+
+Fitness PrefixCache::replay(const PolicyPlan& plan, const int* chromosome, int row, int first_state, Lane& lane){
+    std::vector<float>& work = lane.work;
+    float* job_end_time     = work.data();
+    float* machine_end_time = work.data() + num_jobs;
+    float tot_energy        = work[num_jobs + num_machines];
+
+    const int* jobs = plan.jobs.data();
+    int start = first_state * stride;
+
+    for(int priority = start; priority < num_ops; ++priority){
+        if(priority != start && priority % stride == 0){
+            work[num_jobs + num_machines] = tot_energy;
+            std::memcpy(state(row, priority / stride), work.data(), state_size * sizeof(float));
+        }
+
+        int machine     = chromosome[priority];
+        int current_job = jobs[priority];
+
+        // Same operations, in the same order, as evaluate()
+        TimeEnergy cost = plan.costRow(priority)[machine];
+
+        float best_time = std::max(job_end_time[current_job], machine_end_time[machine]);
+        best_time += cost.time;
+
+        job_end_time[current_job] = best_time;
+        machine_end_time[machine] = best_time;
+
+        tot_energy += cost.energy;
+    }
+    lane.replayed_ops += std::max(0, num_ops - start);
+
+    Fitness fitness;
+    fitness.makespan = *std::max_element(machine_end_time, machine_end_time + num_machines);
+    fitness.energy   = tot_energy;
+
+    final_fitness[row] = fitness;
+    row_plan[row] = &plan;
+    row_states[row] = num_states;
+    return fitness;
+}
+
+Fitness PrefixCache::evaluate(const PolicyPlan& plan, const int* chromosome, int row, int lane){
+    Lane& current = lanes[lane];
+    current.requested_ops += num_ops;
+
+    std::fill(current.work.begin(), current.work.end(), 0.0f);
+    std::memcpy(state(row, 0), current.work.data(), state_size * sizeof(float));
+    return replay(plan, chromosome, row, 0, current);
+}
+
+Fitness PrefixCache::evaluate(const PolicyPlan& plan, const int* chromosome, int row, const GeneDelta& delta, int lane){
+    int base = delta.base_row;
+    Lane& current = lanes[lane];
+
+    // Unchanged chromosome, its states and fitness are the ones of the base
+    if(unchanged(plan, row, delta)){
+        current.requested_ops += num_ops;
+        std::memcpy(state(row, 0), state(base, 0), static_cast<size_t>(row_states[base]) * state_size * sizeof(float));
+        final_fitness[row] = final_fitness[base];
+        row_plan[row] = &plan;
+        row_states[row] = row_states[base];
+        return final_fitness[row];
+    }
+
+    if(base < 0 || base == row || row_plan[base] != &plan || delta.first_changed < stride){
+        return evaluate(plan, chromosome, row, lane);
+    }
+    current.requested_ops += num_ops;
+
+    // The states up to the first change are shared with the base
+    int first_state = std::min(delta.first_changed / stride, row_states[base] - 1);
+    std::memcpy(state(row, 0), state(base, 0), static_cast<size_t>(first_state + 1) * state_size * sizeof(float));
+    std::memcpy(current.work.data(), state(base, first_state), state_size * sizeof(float));
+    return replay(plan, chromosome, row, first_state, current);
+}
+
+void PrefixCache::adopt(const PolicyPlan& plan, int row, const GeneDelta* delta, const Fitness& fitness){
+    int base = delta ? delta->base_row : -1;
+    if(base < 0 || base == row || row_plan[base] != &plan || delta->first_changed < stride){
+        invalidate(row);
+        return;
+    }
+    int shared_states = std::min(delta->first_changed / stride + 1, row_states[base]);
+    std::memcpy(state(row, 0), state(base, 0), static_cast<size_t>(shared_states) * state_size * sizeof(float));
+    final_fitness[row] = fitness;
+    row_plan[row] = &plan;
+    row_states[row] = shared_states;
+}
+
+float evaluateIndividual(const SchedulePlan& plan, const GeneArena& arena, Population& population, int ind,
+PrefixCache& cache, const IndividualDelta* delta, FitnessCache* fitness_cache,
+int lane){
+    float best_makespan = 1e9;
+    forEachPolicy([&](auto policy_constant){
+        constexpr PolicyType policy = decltype(policy_constant)::value;
+        constexpr int p = static_cast<int>(policy);
+        int row = population.row(policy, ind);
+        const int* chromosome = arena.row(row);
+        const PolicyPlan& policy_plan = plan[p];
+
+        const GeneDelta* policy_delta = delta ? &(*delta)[p] : nullptr;
+
+        // A child equal to its base only copies the base's states, cheaper than a lookup
+        Fitness fitness;
+        if(policy_delta && cache.unchanged(policy_plan, row, *policy_delta)){
+            fitness = cache.evaluate(policy_plan, chromosome, row, *policy_delta, lane);
+        }else if(fitness_cache && fitness_cache->lookup(policy, chromosome, fitness)){
+            cache.adopt(policy_plan, row, policy_delta, fitness);
+        }else{
+            fitness = policy_delta ? cache.evaluate(policy_plan, chromosome, row, *policy_delta, lane)
+                                   : cache.evaluate(policy_plan, chromosome, row, lane);
+            if(fitness_cache) fitness_cache->insert(policy, chromosome, fitness);
+        }
+
+        population.times(policy)[ind]    = fitness.makespan;
+        population.energies(policy)[ind] = fitness.energy;
+
+        best_makespan = std::min(best_makespan, fitness.makespan);
+    });
+    return best_makespan;
+}
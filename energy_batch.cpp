@@ -0,0 +1,125 @@
+#include "headers/energy_batch.h"
+#include "headers/nsgaII.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define HAS_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+static bool cpuSupports(SimdLevel level){
+#ifdef HAS_X86_SIMD
+    switch(level){
+        case SimdLevel::SCALAR: return true;
+        case SimdLevel::AVX2:   return __builtin_cpu_supports("avx2");
+        case SimdLevel::AVX512: return __builtin_cpu_supports("avx512f");
+    }
+    return false;
+#else
+    return level == SimdLevel::SCALAR;
+#endif
+}
+
+SimdLevel detectSimdLevel(){
+    static const SimdLevel level = cpuSupports(SimdLevel::AVX512) ? SimdLevel::AVX512
+                                 : cpuSupports(SimdLevel::AVX2)   ? SimdLevel::AVX2
+                                                                  : SimdLevel::SCALAR;
+    return level;
+}
+
+const char* simdLevelName(SimdLevel level){
+    switch(level){
+        case SimdLevel::SCALAR: return "scalar";
+        case SimdLevel::AVX2:   return "avx2";
+        case SimdLevel::AVX512: return "avx512";
+    }
+    return "scalar";
+}
+
+#ifdef HAS_X86_SIMD
+// The genes of lane k are read at chromosomes[0] + priority + offset k (bytes), the energy of
+// a gene at float (cost row * machines + machine) * 2 + 1 of the (time, energy) pairs
+
+__attribute__((target("avx2")))
+static void energyBlockAvx2(const PolicyPlan& plan, const int* const* chromosomes, float* energies){
+    const int* base = chromosomes[0];
+    auto offset = [&](int k){
+        return static_cast<long long>(reinterpret_cast<intptr_t>(chromosomes[k]) - reinterpret_cast<intptr_t>(base));
+    };
+    const __m256i offsets_low  = _mm256_setr_epi64x(offset(0), offset(1), offset(2), offset(3));
+    const __m256i offsets_high = _mm256_setr_epi64x(offset(4), offset(5), offset(6), offset(7));
+    const float* costs = reinterpret_cast<const float*>(plan.costs);
+    const __m256i one  = _mm256_set1_epi32(1);
+
+    __m256 total = _mm256_setzero_ps();
+    for(int priority = 0; priority < plan.num_ops; ++priority){
+        const int* genes = base + priority;
+        __m128i low  = _mm256_i64gather_epi32(genes, offsets_low, 1);
+        __m128i high = _mm256_i64gather_epi32(genes, offsets_high, 1);
+        __m256i machines = _mm256_set_m128i(high, low);
+
+        __m256i cell = _mm256_add_epi32(machines, _mm256_set1_epi32(plan.cost_rows[priority] * plan.num_machines));
+        __m256i index = _mm256_add_epi32(_mm256_slli_epi32(cell, 1), one);
+        total = _mm256_add_ps(total, _mm256_i32gather_ps(costs, index, 4));
+    }
+    _mm256_storeu_ps(energies, total);
+}
+
+__attribute__((target("avx512f")))
+static void energyBlockAvx512(const PolicyPlan& plan, const int* const* chromosomes, float* energies){
+    const int* base = chromosomes[0];
+    auto offset = [&](int k){
+        return static_cast<long long>(reinterpret_cast<intptr_t>(chromosomes[k]) - reinterpret_cast<intptr_t>(base));
+    };
+    const __m512i offsets_low  = _mm512_setr_epi64(offset(0), offset(1), offset(2), offset(3),
+                                                   offset(4), offset(5), offset(6), offset(7));
+    const __m512i offsets_high = _mm512_setr_epi64(offset(8), offset(9), offset(10), offset(11),
+                                                   offset(12), offset(13), offset(14), offset(15));
+    const float* costs = reinterpret_cast<const float*>(plan.costs);
+    const __m512i one  = _mm512_set1_epi32(1);
+    const __m512i zero = _mm512_setzero_si512();
+
+    __m512 total = _mm512_setzero_ps();
+    for(int priority = 0; priority < plan.num_ops; ++priority){
+        const int* genes = base + priority;
+        // Masked forms with a zero source, the plain ones start from an undefined register
+        __m256i low  = _mm512_mask_i64gather_epi32(_mm256_setzero_si256(), 0xFF, offsets_low, genes, 1);
+        __m256i high = _mm512_mask_i64gather_epi32(_mm256_setzero_si256(), 0xFF, offsets_high, genes, 1);
+        __m512i machines = _mm512_mask_inserti64x4(zero, 0xFF, _mm512_castsi256_si512(low), high, 1);
+
+        __m512i cell = _mm512_add_epi32(machines, _mm512_set1_epi32(plan.cost_rows[priority] * plan.num_machines));
+        __m512i index = _mm512_add_epi32(_mm512_add_epi32(cell, cell), one);
+        total = _mm512_add_ps(total, _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xFFFF, index, costs, 4));
+    }
+    _mm512_storeu_ps(energies, total);
+}
+#endif
+
+void totalEnergyBatch(const PolicyPlan& plan, const int* const* chromosomes, int count, float* energies){
+    totalEnergyBatch(plan, chromosomes, count, energies, detectSimdLevel());
+}
+
+void totalEnergyBatch(const PolicyPlan& plan, const int* const* chromosomes, int count, float* energies,
+                      SimdLevel level){
+    // The gathers index the costs with 32 bit integers. The rows read are the priorities
+    // of an ordered plan but the instance rows of an unordered one, so the bound is the
+    // largest row actually read
+    int max_row = plan.num_ops > 0 ? *std::max_element(plan.cost_rows.begin(), plan.cost_rows.end()) : 0;
+    long long cost_floats = 2LL * (max_row + 1LL) * plan.num_machines;
+    if(!cpuSupports(level) || cost_floats > INT_MAX) level = SimdLevel::SCALAR;
+
+    int k = 0;
+#ifdef HAS_X86_SIMD
+    if(level == SimdLevel::AVX512){
+        for(; k + 16 <= count; k += 16) energyBlockAvx512(plan, chromosomes + k, energies + k);
+    }
+    if(level == SimdLevel::AVX512 || level == SimdLevel::AVX2){
+        for(; k + 8 <= count; k += 8) energyBlockAvx2(plan, chromosomes + k, energies + k);
+    }
+#endif
+    // Remaining chromosomes, one at a time
+    for(; k < count; ++k) energies[k] = totalEnergy(plan, chromosomes[k]);
+}
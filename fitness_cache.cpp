@@ -0,0 +1,84 @@
+#include "headers/fitness_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Enough locks for the seeds running at the same time to rarely meet
+static const size_t NUM_SHARDS = 64;
+
+FitnessCache::FitnessCache(int gene_length, size_t max_bytes)
+    : gene_length(gene_length), shards(NUM_SHARDS){
+    size_t slot_bytes = static_cast<size_t>(gene_length) * sizeof(int) + sizeof(uint64_t) + sizeof(signed char) + sizeof(Fitness);
+    slots_per_shard = max_bytes / slot_bytes / NUM_SHARDS;
+
+    for(Shard& shard : shards){
+        shard.hashes.assign(slots_per_shard, 0);
+        shard.policies.assign(slots_per_shard, -1);
+        shard.fitness.assign(slots_per_shard, {0.0f, 0.0f});
+        shard.genes.assign(slots_per_shard * gene_length, 0);
+    }
+}
+
+size_t FitnessCache::capacity() const{
+    return slots_per_shard * NUM_SHARDS;
+}
+
+// FNV-1a over the genes, with a final mix so the low bits (the slot) depend on every gene
+uint64_t FitnessCache::hash(PolicyType policy, const int* chromosome) const{
+    uint64_t h = 14695981039346656037ULL ^ static_cast<uint64_t>(policy);
+    for(int i = 0; i < gene_length; ++i){
+        h ^= static_cast<uint32_t>(chromosome[i]);
+        h *= 1099511628211ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+bool FitnessCache::lookup(PolicyType policy, const int* chromosome, Fitness& fitness){
+    if(slots_per_shard == 0) return false;
+    lookups.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t h = hash(policy, chromosome);
+    Shard& shard = shards[(h >> 32) % NUM_SHARDS];
+    size_t slot = h % slots_per_shard;
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if(shard.policies[slot] != static_cast<signed char>(policy) || shard.hashes[slot] != h) return false;
+
+    const int* stored = shard.genes.data() + slot * gene_length;
+    if(!std::equal(stored, stored + gene_length, chromosome)) return false;
+
+    fitness = shard.fitness[slot];
+    hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void FitnessCache::insert(PolicyType policy, const int* chromosome, const Fitness& fitness){
+    if(slots_per_shard == 0) return;
+
+    uint64_t h = hash(policy, chromosome);
+    Shard& shard = shards[(h >> 32) % NUM_SHARDS];
+    size_t slot = h % slots_per_shard;
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    bool replaces = shard.policies[slot] >= 0 &&
+                    (shard.hashes[slot] != h || shard.policies[slot] != static_cast<signed char>(policy));
+    if(replaces) evictions.fetch_add(1, std::memory_order_relaxed);
+    inserts.fetch_add(1, std::memory_order_relaxed);
+
+    shard.hashes[slot]   = h;
+    shard.policies[slot] = static_cast<signed char>(policy);
+    shard.fitness[slot]  = fitness;
+    std::memcpy(shard.genes.data() + slot * gene_length, chromosome, gene_length * sizeof(int));
+}
+
+FitnessCache::Stats FitnessCache::stats() const{
+    Stats result;
+    result.lookups   = lookups.load(std::memory_order_relaxed);
+    result.hits      = hits.load(std::memory_order_relaxed);
+    result.inserts   = inserts.load(std::memory_order_relaxed);
+    result.evictions = evictions.load(std::memory_order_relaxed);
+    return result;
+}
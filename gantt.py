@@ -3,10 +3,51 @@ import matplotlib.pyplot as plt
 import numpy as np
 import matplotlib.patches as mpatches
 import os
+import io
+import re
+
+GANTT_COLUMNS = ['Machine_ID', 'Job_ID', 'Operation_ID', 'Start_Time', 'End_Time']
+_packed_indices = {}
+
+def read_gantt(file_path):
+    """
+    Lee un Gantt de results/<instancia>/<politica>/seed_X_solution_Y.txt.
+    Si la corrida se hizo con --gantt packed, ese archivo no existe y el Gantt
+    se lee de results/<instancia>/gantt_schedules.csv usando gantt_index.csv.
+    """
+    if os.path.exists(file_path):
+        return pd.read_csv(file_path)
+
+    policy_dir, file_name = os.path.split(file_path)
+    instance_dir, policy = os.path.split(policy_dir)
+    match = re.match(r'seed_(\d+)_solution_(\d+)\.txt$', file_name)
+    index_path = os.path.join(instance_dir, 'gantt_index.csv')
+    if not match or not os.path.exists(index_path):
+        raise FileNotFoundError(file_path)
+
+    if index_path not in _packed_indices:
+        _packed_indices[index_path] = pd.read_csv(index_path).set_index(['Seed', 'Policy', 'Solution'])
+    index = _packed_indices[index_path]
+
+    key = (int(match.group(1)), policy, int(match.group(2)))
+    if key not in index.index:
+        raise FileNotFoundError(file_path)
+    entry = index.loc[key]
+
+    # Solo se leen los bytes de ese Gantt
+    with open(os.path.join(instance_dir, 'gantt_schedules.csv'), 'rb') as packed:
+        packed.seek(int(entry['Offset']))
+        chunk = packed.read(int(entry['Bytes'])).decode()
+
+    if not chunk:
+        raise pd.errors.EmptyDataError(file_path)
+    df = pd.read_csv(io.StringIO(chunk), header=None,
+                     names=['Seed', 'Policy', 'Solution'] + GANTT_COLUMNS)
+    return df[GANTT_COLUMNS]
 
 def plot_gantt_on_ax(ax, file_path, policy_name):
     try:
-        df = pd.read_csv(file_path)
+        df = read_gantt(file_path)
     except FileNotFoundError:
         ax.text(0.5, 0.5, f"Archivo no encontrado:\n{os.path.basename(file_path)}", 
                 ha='center', va='center', color='red', fontsize=10)
@@ -0,0 +1,155 @@
+#include "headers/gantt_export.h"
+
+#include <iostream>
+#include <string_view>
+
+static const char* GANTT_HEADER = "Machine_ID,Job_ID,Operation_ID,Start_Time,End_Time\n";
+
+// Gantt rows, prefix holds the leading fields of every row (the packed file adds seed, policy, solution)
+static int appendGantt(CsvBuffer& out, const std::vector<std::vector<Gantt>>& gantt_chart, std::string_view prefix = {}){
+    int rows = 0;
+    for(size_t machine_id = 0; machine_id < gantt_chart.size(); ++machine_id){
+        for (const auto& task : gantt_chart[machine_id]) {
+            if(!prefix.empty()) out.append(prefix);
+            out.add(static_cast<int>(machine_id) + 1)
+               .add(task.job + 1)
+               .add(task.operation + 1)
+               .add(task.initial_time)
+               .add(task.end_time);
+            out.endRow();
+            ++rows;
+        }
+    }
+    return rows;
+}
+
+void saveGanttToFile(const std::string& file_path, const std::vector<std::vector<Gantt>>& gantt_chart){
+    // The whole file is built in memory and written at once
+    CsvBuffer csv;
+    csv.append(GANTT_HEADER);
+    appendGantt(csv, gantt_chart);
+
+    BufferedFile output_file(0); // Nothing to buffer, there's a single write
+    if(!output_file.open(file_path)){
+        std::cerr << "Error: No se pudo abrir el archivo de Gantt: " << file_path << std::endl;
+        return;
+    }
+    output_file.write(csv.str());
+    if(!output_file.close()) std::cerr << "Error: No se pudo escribir el archivo de Gantt: " << file_path << std::endl;
+}
+
+GanttExporter::GanttExporter(const SchedulePlan& plan, const RunConfig& config, const std::string& base_path,
+                             size_t capacity)
+    : plan(plan), config(config), base_path(base_path), capacity(capacity > 0 ? capacity : 1){}
+
+GanttExporter::~GanttExporter(){
+    finish();
+}
+
+bool GanttExporter::start(){
+    if(config.gantt_output == GanttOutput::NONE) return true;
+
+    // Every Gantt of the run in one file, plus an index to find each schedule
+    if(config.gantt_output == GanttOutput::PACKED){
+        std::string packed_filepath = base_path + "/gantt_schedules.csv";
+        if(!packed_file.open(packed_filepath)){
+            std::cerr << "Error: Could'nt open the Gantt file: " << packed_filepath << std::endl;
+            return false;
+        }
+        packed_file.write("Seed,Policy,Solution,Machine_ID,Job_ID,Operation_ID,Start_Time,End_Time\n");
+        packed_index.append("Seed,Policy,Solution,Offset,Bytes,Rows\n");
+    }
+
+    worker = std::thread(&GanttExporter::run, this);
+    return true;
+}
+
+void GanttExporter::push(GanttBatch batch){
+    if(!worker.joinable()) return;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock, [this]{ return batches.size() < capacity; });
+        batches.push_back(std::move(batch));
+    }
+    not_empty.notify_one();
+}
+
+void GanttExporter::finish(){
+    if(!worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finishing = true;
+    }
+    not_empty.notify_one();
+    worker.join();
+
+    if(packed_file.isOpen()){
+        packed_file.close();
+        std::string index_filepath = base_path + "/gantt_index.csv";
+        BufferedFile index_file;
+        if(index_file.open(index_filepath)){
+            index_file.write(packed_index.str());
+            index_file.close();
+        }else{
+            std::cerr << "Error: Could'nt open the Gantt index: " << index_filepath << std::endl;
+        }
+    }
+}
+
+void GanttExporter::run(){
+    while(true){
+        GanttBatch batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            not_empty.wait(lock, [this]{ return finishing || !batches.empty(); });
+            if(batches.empty()) return; // Finishing and nothing left
+            batch = std::move(batches.front());
+            batches.pop_front();
+        }
+        not_full.notify_one();
+
+        batch_profiles.emplace_back();
+        batch_profiles.back().seed = batch.seed;
+        exportBatch(batch, batch_profiles.back());
+    }
+}
+
+void GanttExporter::exportBatch(const GanttBatch& batch, SeedProfile& profile){
+    PROFILE_SCOPE(profile, Phase::GANTT);
+    CsvBuffer rows;
+    for(int p = 0; p < NUM_POLICIES; ++p){
+        PolicyType policy = static_cast<PolicyType>(p);
+        std::string policy_name = policyToString(policy);
+
+        for(int k = 0; k < batch.frontSize(p); ++k){
+            int sol_idx = k + 1;
+            auto [makespan, gantt] = totalTime(plan[policy], batch.member(p, k));
+
+            if(config.gantt_output == GanttOutput::PACKED){
+                CsvBuffer prefix;
+                prefix.add(batch.seed).add(policy_name).add(sol_idx).add("");
+
+                rows.clear();
+                uint64_t offset = packed_file.bytesWritten();
+                int row_count = appendGantt(rows, gantt, prefix.str());
+                packed_file.write(rows.str());
+
+                packed_index.add(batch.seed)
+                            .add(policy_name)
+                            .add(sol_idx)
+                            .add(offset)
+                            .add(static_cast<uint64_t>(rows.size()))
+                            .add(row_count);
+                packed_index.endRow();
+                continue;
+            }
+
+            std::string gantt_filename = base_path + "/" +
+                                         policy_name +
+                                         "/seed_" + std::to_string(batch.seed) +
+                                         "_solution_" + std::to_string(sol_idx) +
+                                         ".txt";
+            saveGanttToFile(gantt_filename, gantt);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef BINARY_INSTANCE_H
+#define BINARY_INSTANCE_H
+
+#pragma once
+
+#include "individual.h"
+
+#include <cstdint>
+#include <string>
+
+// Binary instance layout (native endianness, every section starts on a 64 bytes boundary):
+//   BinaryInstanceHeader
+//   time table    num_rows x row_stride floats (row-major, padding is 0)
+//   energy table  num_rows x row_stride floats
+//   job offsets   num_jobs + 1 uint32 (CSR, job j owns job_ops[offsets[j], offsets[j + 1]))
+//   job ops       num_job_ops uint32, operation numbers starting at 1 like the text format
+struct BinaryInstanceHeader{
+    char magic[8];       // "PGAINST\0"
+    uint32_t version;
+    uint32_t endianness; // 0x01020304 as written by the machine that made the file
+    uint32_t num_rows;
+    uint32_t num_machines;
+    uint32_t row_stride;
+    uint32_t num_jobs;
+    uint32_t num_job_ops;
+    uint32_t reserved;
+    uint64_t time_offset;
+    uint64_t energy_offset;
+    uint64_t job_offsets_offset;
+    uint64_t job_ops_offset;
+    uint64_t file_size;
+};
+
+bool isBinaryInstance(const std::string& path);
+
+bool saveBinaryInstance(const std::string& path, const Data& data, const vvi& jobs);
+// The tables are copied in bulk from the mapped file, nothing is parsed
+bool loadBinaryInstance(const std::string& path, Data& data, vvi& jobs);
+
+// Text instance (test/testcase_structure.txt) to binary
+bool convertToBinary(const std::string& text_path, const std::string& binary_path);
+
+// "test/Eg1.bin" for "test/Eg1.txt"
+std::string binaryPathFor(const std::string& text_path);
+
+// Loads any instance file, the format is detected from its first bytes. With use_cache a text
+// instance is converted once to binaryPathFor(path) and that copy is used while it's up to date
+bool openInstance(const std::string& path, Data& data, vvi& jobs, bool use_cache);
+
+#endif // BINARY_INSTANCE_H
@@ -0,0 +1,95 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Non-dominated sorting algorithms, selectable at runtime
+enum class SortMethod{
+    REFERENCE, // Deb's fast non-dominated sort, O(MN^2)
+    SWEEP      // Bi-objective sort-and-sweep, O(N log N)
+};
+
+// How the Gantt diagrams of the final Pareto fronts are saved
+enum class GanttOutput{
+    FILES,  // One CSV per solution: <policy>/seed_<seed>_solution_<n>.txt
+    PACKED, // Every schedule in gantt_schedules.csv, located through gantt_index.csv
+    NONE
+};
+
+// Evolution scheme of every seed
+enum class Engine{
+    GENERATIONAL, // NSGA-II, a whole offspring population per generation
+    STEADY_STATE, // Offspring replace the worst members one at a time
+    ISLAND        // Several generational populations exchanging their best members
+};
+
+// Who an island sends its migrants to
+enum class Topology{
+    RING, // The next island
+    ALL   // Every other island
+};
+
+// Random numbers of the genetic operators
+enum class RngMode{
+    MT19937, // One sequence per island drawn in order, the original results
+    STREAMS  // Counter-based streams per (seed, island, generation, slot, child, policy), breeding in parallel
+};
+
+// Everything a run can change without recompiling. Defaults are the original experiment
+struct RunConfig{
+    int population_size     = 10;
+    int generation_size     = 100;
+    int checkpoint_interval = 20; // Pareto fronts are logged every N generations (and gen 1)
+
+    // 30 Semillas requeridas
+    std::vector<int> seeds = {0, 1, 2, 3, 5, 7, 11, 13, 17, 19,
+                              23, 29, 31, 37, 41, 43, 47, 53, 59, 61,
+                              67, 71, 73, 79, 83, 89, 97, 101, 103, 107};
+
+    // 3 test cases provided
+    std::vector<std::string> instances = {"test/Eg1.txt", "test/Eg2.txt", "test/Eg3.txt"};
+
+    std::string output_dir = "results";
+    unsigned int num_threads = 0; // 0 uses every core available
+    bool parallel_generation = true; // Policies and individuals of a generation are spread over the threads too
+    SortMethod sort_method = SortMethod::REFERENCE;
+
+    GanttOutput gantt_output = GanttOutput::FILES;
+    int gantt_queue = 2; // Seeds waiting for the Gantt export thread, the main thread waits beyond it
+
+    Engine engine = Engine::GENERATIONAL;
+    int num_islands        = 4;  // Island model only, each island has population_size individuals
+    int migration_interval = 10; // Generations between migrations
+    int migration_size     = 2;  // Migrants per policy sent to every neighbour
+    Topology topology = Topology::RING;
+
+    RngMode rng_mode = RngMode::MT19937;
+
+    bool incremental_eval = true; // Offspring only replay the schedule after their first changed gene
+    int fitness_cache_mb  = 0;    // Memo of evaluated chromosomes shared by the seeds, 0 = off
+    int plan_cost_mb      = 256;  // Costs copied in priority order for the six policies, above it the instance table is read
+
+    bool write_profile = false; // Time of every phase by seed in profile.csv (needs a build without NO_PROFILING)
+
+    bool binary_cache = false; // Text instances are converted once to .bin and reloaded from there
+    bool convert_only = false; // Only write the .bin copy of every instance
+
+    bool show_help = false; // --help, nothing is run
+};
+
+// "key = value" lines, '#' starts a comment. Keys are the long CLI options without "--"
+bool loadConfigFile(const std::string& path, RunConfig& config);
+
+// Command line options, they override the config file (--config) whatever their position.
+// Returns false on a bad option or value
+bool parseArguments(int argc, char* argv[], RunConfig& config);
+
+void printUsage(const char* program);
+
+// "Eg1" for "test/Eg1.txt"
+std::string instanceName(const std::string& path);
+
+#endif // CONFIG_H
@@ -0,0 +1,83 @@
+#ifndef DELTA_EVAL_H
+#define DELTA_EVAL_H
+
+#pragma once
+
+#include "nsgaII.h"
+
+#include <array>
+#include <vector>
+
+// Schedule state (job end times, machine end times and energy so far) saved every
+// `stride` priorities of every evaluated arena row. A chromosome that shares a prefix
+// with an evaluated one only replays the schedule from the last state before its first
+// change. The replay does the same float operations in the same order as evaluate(),
+// so the fitness is bit-identical to a full evaluation.
+// Rows can be evaluated concurrently as long as every thread uses its own lane and
+// no row is written while another one reads it as a base.
+class PrefixCache{
+private:
+    // Replay buffer and counters of one thread
+    struct alignas(64) Lane{
+        std::vector<float> work; // State being replayed
+        long long replayed_ops  = 0;
+        long long requested_ops = 0;
+    };
+
+    int num_ops;
+    int num_jobs;
+    int num_machines;
+    int stride;
+    int num_states;  // States per row, state k is taken before priority k * stride
+    int state_size;  // jobs + machines + energy
+
+    std::vector<float> states;              // max_rows x num_states x state_size
+    std::vector<Fitness> final_fitness;     // Per row
+    std::vector<const PolicyPlan*> row_plan; // Plan the row was evaluated with, nullptr = none
+    std::vector<int> row_states;             // Valid states of the row, fewer than num_states when
+                                             // its fitness came from the fitness cache
+
+    std::vector<Lane> lanes;
+
+    float* state(int row, int k){
+        return states.data() + (static_cast<size_t>(row) * num_states + k) * state_size;
+    }
+
+    // Replays priorities [first_state * stride, num_ops) from the state in the lane's work,
+    // the states after first_state are saved into row
+    Fitness replay(const PolicyPlan& plan, const int* chromosome, int row, int first_state, Lane& lane);
+
+public:
+    PrefixCache(const SchedulePlan& plan, int max_rows, int num_lanes = 1);
+
+    // Full evaluation, the states of row are recorded on the way
+    Fitness evaluate(const PolicyPlan& plan, const int* chromosome, int row, int lane = 0);
+
+    // Reuses the states of delta.base_row up to delta.first_changed when it was evaluated
+    // with the same plan, falls back to evaluate() otherwise
+    Fitness evaluate(const PolicyPlan& plan, const int* chromosome, int row, const GeneDelta& delta, int lane = 0);
+
+    // true when evaluate() with delta only copies the base's states (the chromosome didn't change)
+    bool unchanged(const PolicyPlan& plan, int row, const GeneDelta& delta) const{
+        int base = delta.base_row;
+        return base >= 0 && base != row && row_plan[base] == &plan && delta.first_changed >= num_ops;
+    }
+
+    // The fitness of row came from the fitness cache: it keeps the states it shares with
+    // its base (delta can be nullptr), so its own children still start from them
+    void adopt(const PolicyPlan& plan, int row, const GeneDelta* delta, const Fitness& fitness);
+
+    // The row has no valid states anymore (its fitness came from somewhere else)
+    void invalidate(int row){ row_plan[row] = nullptr; }
+
+    // Priorities actually replayed, to measure what the cache saves
+    long long replayedOps() const;
+    long long requestedOps() const;
+};
+
+// evaluateIndividual() through the prefix cache, delta can be nullptr (no base)
+float evaluateIndividual(const SchedulePlan& plan, const GeneArena& arena, Population& population, int ind,
+PrefixCache& cache, const IndividualDelta* delta, FitnessCache* fitness_cache = nullptr,
+int lane = 0);
+
+#endif // DELTA_EVAL_H
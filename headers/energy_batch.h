@@ -0,0 +1,28 @@
+#ifndef ENERGY_BATCH_H
+#define ENERGY_BATCH_H
+
+#pragma once
+
+#include "schedule_plan.h"
+
+// Instruction sets of the batch kernels
+enum class SimdLevel{
+    SCALAR,
+    AVX2,
+    AVX512
+};
+
+// Widest level both the CPU and this build support, detected once
+SimdLevel detectSimdLevel();
+const char* simdLevelName(SimdLevel level);
+
+// energies[k] = totalEnergy(plan, chromosomes[k]) for k in [0, count). Every vector lane is
+// one chromosome and adds its energies in priority order like the scalar loop, so the
+// results are bit-identical to it. Runs with detectSimdLevel()
+void totalEnergyBatch(const PolicyPlan& plan, const int* const* chromosomes, int count, float* energies);
+
+// Same on a given level, one the CPU can't run falls back to the scalar loop
+void totalEnergyBatch(const PolicyPlan& plan, const int* const* chromosomes, int count, float* energies,
+                      SimdLevel level);
+
+#endif // ENERGY_BATCH_H
@@ -0,0 +1,63 @@
+#ifndef FITNESS_CACHE_H
+#define FITNESS_CACHE_H
+
+#pragma once
+
+#include "nsgaII.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Bounded memo of already evaluated chromosomes: (policy, genes) -> (makespan, energy).
+// The fitness only depends on the instance, so one cache is shared by every seed of it.
+// Entries keep their genes, a hash collision is never taken as a hit.
+class FitnessCache{
+public:
+    struct Stats{
+        uint64_t lookups   = 0;
+        uint64_t hits      = 0;
+        uint64_t inserts   = 0;
+        uint64_t evictions = 0; // An insert that replaced another chromosome
+
+        double hitRate() const{ return lookups ? static_cast<double>(hits) / lookups : 0.0; }
+    };
+
+private:
+    // Direct mapped slots, every shard has its own lock
+    struct Shard{
+        std::mutex mutex;
+        std::vector<uint64_t> hashes;
+        std::vector<signed char> policies; // -1 = empty slot
+        std::vector<Fitness> fitness;
+        std::vector<int> genes;            // slots x gene_length
+    };
+
+    int gene_length;
+    size_t slots_per_shard;
+    std::vector<Shard> shards;
+
+    std::atomic<uint64_t> lookups{0};
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> inserts{0};
+    std::atomic<uint64_t> evictions{0};
+
+    uint64_t hash(PolicyType policy, const int* chromosome) const;
+
+public:
+    // The cache never takes more than about max_bytes
+    FitnessCache(int gene_length, size_t max_bytes);
+
+    FitnessCache(const FitnessCache&) = delete;
+    FitnessCache& operator=(const FitnessCache&) = delete;
+
+    size_t capacity() const;
+
+    bool lookup(PolicyType policy, const int* chromosome, Fitness& fitness);
+    void insert(PolicyType policy, const int* chromosome, const Fitness& fitness);
+
+    Stats stats() const;
+};
+
+#endif // FITNESS_CACHE_H
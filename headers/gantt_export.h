@@ -0,0 +1,78 @@
+#ifndef GANTT_EXPORT_H
+#define GANTT_EXPORT_H
+
+#pragma once
+
+#include "config.h"
+#include "nsgaII.h"
+#include "output.h"
+#include "profiler.h"
+#include "schedule_plan.h"
+
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Writes one schedule as a CSV file with its header
+void saveGanttToFile(const std::string& file_path, const std::vector<std::vector<Gantt>>& gantt_chart);
+
+// Final Pareto fronts of one seed. The chromosomes are copied out of the seed's arena
+// in export order, so the seed's buffers can go away before they're written
+struct GanttBatch{
+    int seed = 0;
+    int gene_length = 0;
+    std::array<std::vector<int>, NUM_POLICIES> genes; // Front members one after the other
+
+    int frontSize(int policy) const{ return gene_length ? genes[policy].size() / gene_length : 0; }
+    const int* member(int policy, int k) const{ return genes[policy].data() + static_cast<size_t>(k) * gene_length; }
+};
+
+// Rebuilds the schedules of the seeds' fronts and writes them on its own thread, so the
+// next seeds keep evolving while the previous ones reach the disk. Batches are written in
+// the order they're pushed; once `capacity` of them are waiting push() blocks
+class GanttExporter{
+private:
+    const SchedulePlan& plan;
+    const RunConfig& config;
+    std::string base_path;
+    size_t capacity;
+
+    BufferedFile packed_file; // Only with GanttOutput::PACKED
+    CsvBuffer packed_index;
+
+    std::mutex mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::deque<GanttBatch> batches;
+    bool finishing = false;
+    std::thread worker;
+
+    std::vector<SeedProfile> batch_profiles; // Time of every batch, in push order
+
+    void run();
+    void exportBatch(const GanttBatch& batch, SeedProfile& profile);
+
+public:
+    GanttExporter(const SchedulePlan& plan, const RunConfig& config, const std::string& base_path, size_t capacity);
+    ~GanttExporter();
+
+    GanttExporter(const GanttExporter&) = delete;
+    GanttExporter& operator=(const GanttExporter&) = delete;
+
+    // Opens the packed file and starts the thread, false if the file can't be opened
+    bool start();
+
+    void push(GanttBatch batch);
+
+    // Waits for every batch, then closes the packed file and writes its index
+    void finish();
+
+    // Export time of every batch, in push order. Valid after finish()
+    const std::vector<SeedProfile>& profiles() const{ return batch_profiles; }
+};
+
+#endif // GANTT_EXPORT_H
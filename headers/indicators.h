@@ -0,0 +1,30 @@
+#ifndef INDICATORS_H
+#define INDICATORS_H
+
+#pragma once
+
+#include <vector>
+
+// Quality indicators of bi-objective fronts, both objectives are minimized
+struct ObjectivePoint{
+    double time;
+    double energy;
+};
+
+// Non-dominated points of a set, sorted by time and without duplicates
+std::vector<ObjectivePoint> nonDominatedPoints(std::vector<ObjectivePoint> points);
+
+// Exact 2-D hypervolume (sort + sweep, O(n log n)). Points that don't dominate the
+// reference point add nothing
+double hypervolume(std::vector<ObjectivePoint> front, const ObjectivePoint& reference_point);
+
+// Mean distance from every point of the reference front to its closest point of front
+double invertedGenerationalDistance(const std::vector<ObjectivePoint>& front, const std::vector<ObjectivePoint>& reference_front);
+
+// Deb's spread (delta), 0 means evenly spaced points reaching the extremes of the reference front
+double spread(std::vector<ObjectivePoint> front, const std::vector<ObjectivePoint>& reference_front);
+
+// Additive epsilon: smallest shift that makes front weakly dominate the reference front
+double additiveEpsilon(const std::vector<ObjectivePoint>& front, const std::vector<ObjectivePoint>& reference_front);
+
+#endif // INDICATORS_H
@@ -3,6 +3,11 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 using vvi = std::vector<std::vector<int>>;
@@ -16,73 +21,48 @@ enum class PolicyType{
     RR_LTP,
     RR_ECA
 };
+constexpr int NUM_POLICIES = 6;
 
+// Calls f(std::integral_constant<PolicyType, P>{}) for every policy, in enum order. The
+// policy is a constant expression inside f, so its body is compiled once per policy
+template <typename F, int... P>
+inline void forEachPolicy(F&& f, std::integer_sequence<int, P...>){
+    (f(std::integral_constant<PolicyType, static_cast<PolicyType>(P)>{}), ...);
+}
+
+template <typename F>
+inline void forEachPolicy(F&& f){
+    forEachPolicy(std::forward<F>(f), std::make_integer_sequence<int, NUM_POLICIES>{});
+}
+
+// One value per policy, indexed by the enum
 template <typename T>
 struct BasePolicies{
-    T fifo    = T{}; // 0 for int and 0.0f for float
-    T ltp     = T{};
-    T stp     = T{};
-    T rr_fifo = T{};
-    T rr_ltp  = T{};
-    T rr_eca  = T{};
-
-    T getValue(PolicyType policy) const{
-        switch(policy){
-            case PolicyType::FIFO:    return fifo;
-            case PolicyType::LTP:     return ltp;
-            case PolicyType::STP:     return stp;
-            case PolicyType::RR_FIFO: return rr_fifo;
-            case PolicyType::RR_LTP:  return rr_ltp;
-            case PolicyType::RR_ECA:  return rr_eca;
-            default:                  return T{};
-        }
-    }
+    std::array<T, NUM_POLICIES> values{}; // 0 for int and 0.0f for float
 
-    void setValue(PolicyType policy, T value){
-        switch(policy){
-            case PolicyType::FIFO:    fifo = value; break;
-            case PolicyType::LTP:     ltp  = value; break;
-            case PolicyType::STP:     stp  = value; break;
-            case PolicyType::RR_FIFO: rr_fifo = value; break;
-            case PolicyType::RR_LTP:  rr_ltp  = value; break;
-            case PolicyType::RR_ECA:  rr_eca  = value; break;
-        }
-    }
+    template <PolicyType P>
+    T& get(){ return std::get<static_cast<int>(P)>(values); }
+    template <PolicyType P>
+    const T& get() const{ return std::get<static_cast<int>(P)>(values); }
+
+    T getValue(PolicyType policy) const{ return values[static_cast<int>(policy)]; }
+    void setValue(PolicyType policy, T value){ values[static_cast<int>(policy)] = value; }
 };
 
 using Policies     = BasePolicies<float>;
 using RankPolicies = BasePolicies<int>;
 
 struct Chromosome{
-    std::vector<int> fifo;
-    std::vector<int> ltp;
-    std::vector<int> stp;
-    std::vector<int> rr_fifo;
-    std::vector<int> rr_ltp;
-    std::vector<int> rr_eca;
-
-    std::vector<int>& getValue(PolicyType policy){
-        switch(policy){
-            case PolicyType::FIFO:    return fifo;
-            case PolicyType::LTP:     return ltp;
-            case PolicyType::STP:     return stp;
-            case PolicyType::RR_FIFO: return rr_fifo;
-            case PolicyType::RR_LTP:  return rr_ltp;
-            case PolicyType::RR_ECA:  return rr_eca;
-            default:                  return fifo;
-        }
-    }
+    std::array<std::vector<int>, NUM_POLICIES> genes;
 
-    void setValue(PolicyType policy, std::vector<int>& value){
-        switch(policy){
-            case PolicyType::FIFO:    fifo = value; break;
-            case PolicyType::LTP:     ltp  = value; break;
-            case PolicyType::STP:     stp  = value; break;
-            case PolicyType::RR_FIFO: rr_fifo = value; break;
-            case PolicyType::RR_LTP:  rr_ltp  = value; break;
-            case PolicyType::RR_ECA:  rr_eca  = value; break;
-        }
-    }
+    template <PolicyType P>
+    std::vector<int>& get(){ return std::get<static_cast<int>(P)>(genes); }
+    template <PolicyType P>
+    const std::vector<int>& get() const{ return std::get<static_cast<int>(P)>(genes); }
+
+    std::vector<int>& getValue(PolicyType policy){ return genes[static_cast<int>(policy)]; }
+    const std::vector<int>& getValue(PolicyType policy) const{ return genes[static_cast<int>(policy)]; }
+    void setValue(PolicyType policy, std::vector<int>& value){ genes[static_cast<int>(policy)] = value; }
 };
 
 struct Individual{
@@ -95,32 +75,39 @@ struct Individual{
     RankPolicies rank; // Dominance level
 };
 
-struct IndividualComparator{
-    // What policy will it compare?
-    PolicyType policy;
+// Allocator for SIMD friendly storage, every block starts on an ALIGN bytes boundary
+template <typename T, std::size_t ALIGN>
+struct AlignedAllocator{
+    using value_type = T;
+
+    template <typename U>
+    struct rebind{ using other = AlignedAllocator<U, ALIGN>; };
 
-    IndividualComparator(PolicyType p) : policy(p){}
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, ALIGN>&){}
 
-    // std::sort will use this
-    bool operator()(const Individual& a, const Individual& b) const{
-        // Compare ranks
-        int rank_a = a.rank.getValue(policy);
-        int rank_b = b.rank.getValue(policy);
+    T* allocate(std::size_t n){
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(ALIGN)));
+    }
+    void deallocate(T* p, std::size_t){
+        ::operator delete(p, std::align_val_t(ALIGN));
+    }
 
-        if(rank_a < rank_b){
-            return true;
-        }
-        if(rank_a > rank_b){
-            return false;
-        }
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, ALIGN>&) const{ return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, ALIGN>&) const{ return false; }
+};
 
-        // If the rank is the same, compare by CD
-        float cd_a = a.crowding_distance.getValue(policy);
-        float cd_b = b.crowding_distance.getValue(policy);
+// One AVX-512 register of floats, rows are padded to it
+constexpr int SIMD_WIDTH = 16;
+using aligned_vf = std::vector<float, AlignedAllocator<float, SIMD_WIDTH * sizeof(float)>>;
 
-        // Descendending
-        return cd_a > cd_b;
-    }
+// Time and energy of an (operation, machine) pair next to each other
+struct TimeEnergy{
+    float time;
+    float energy;
 };
 
 class Data{
@@ -129,20 +116,88 @@ private:
     int total_operations; 
     int total_jobs;
 
-    vvf task_time;
-    vvf task_energy;
+    int num_rows;   // Operations in the time/energy tables
+    int row_stride; // num_machines rounded up to SIMD_WIDTH
+    int col_stride; // num_rows rounded up to SIMD_WIDTH (machine-major tables)
+
+    // Row-major (operation x row_stride), padding is 0
+    aligned_vf task_time;
+    aligned_vf task_energy;
+    std::vector<TimeEnergy> task_time_energy; // operation x num_machines
+
+    // Optional machine-major copies (machine x col_stride)
+    aligned_vf machine_time;
+    aligned_vf machine_energy;
 
 public:
     Data();
 
     bool loadInstance(const vvf& time, const vvf& energy, const vvi& jobs);
 
+    // Direct loading without intermediate tables: allocateTables, fill the rows through
+    // mutableTimeRow/mutableEnergyRow and then finishLoading
+    void allocateTables(int rows, int machines);
+    float* mutableTimeRow(int task);
+    float* mutableEnergyRow(int task);
+    void finishLoading(const vvi& jobs);
+
+    // Builds the machine-major copies of the tables, not needed by the evaluators
+    void buildMachineMajor();
+
     int getNumMachines() const;
     int getNumTasks() const;
     int getNumJobs() const;
+    int getNumRows() const;
+    int getRowStride() const;
+    bool hasMachineMajor() const;
     
     float getTime(int task, int machine) const;
     float getEnergy(int task, int machine) const;
+    TimeEnergy getTimeEnergy(int task, int machine) const;
+    const TimeEnergy* timeEnergyRow(int task) const; // num_machines pairs
+
+    // Contiguous views, rows are row_stride long and SIMD aligned
+    const float* timeRow(int task) const;
+    const float* energyRow(int task) const;
+    // Only valid after buildMachineMajor(), columns are getNumRows() long
+    const float* machineTimes(int machine) const;
+    const float* machineEnergies(int machine) const;
 };
 
+// The accessors live in the header so the evaluators can inline them
+
+// Operation and Machine in the table
+inline float Data::getTime(int task, int machine) const{ 
+    return task_time[task * row_stride + machine];
+}
+
+// Operation and Machine in the table
+inline float Data::getEnergy(int task, int machine) const{
+    return task_energy[task * row_stride + machine];
+}
+
+inline TimeEnergy Data::getTimeEnergy(int task, int machine) const{
+    return task_time_energy[task * num_machines + machine];
+}
+
+inline const TimeEnergy* Data::timeEnergyRow(int task) const{
+    return task_time_energy.data() + static_cast<size_t>(task) * num_machines;
+}
+
+inline const float* Data::timeRow(int task) const{
+    return task_time.data() + task * row_stride;
+}
+
+inline const float* Data::energyRow(int task) const{
+    return task_energy.data() + task * row_stride;
+}
+
+inline const float* Data::machineTimes(int machine) const{
+    return machine_time.data() + machine * col_stride;
+}
+
+inline const float* Data::machineEnergies(int machine) const{
+    return machine_energy.data() + machine * col_stride;
+}
+
 #endif // INDIVIDUAL_H
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef INSTANCE_GENERATOR_H
+#define INSTANCE_GENERATOR_H
+
+#pragma once
+
+#include "individual.h"
+
+#include <cstdint>
+#include <string>
+
+// Shape of a synthetic instance. Same parameters and seed give the same instance
+// (with the same standard library, the distributions aren't portable between them)
+struct GeneratorParams{
+    uint64_t seed       = 1;
+    int operations      = 1000; // Operations of all the jobs together
+    int operation_types = 0;    // Rows of the tables, 0 = one per operation (jobs don't share operations)
+    int machines        = 10;
+    int jobs            = 100;
+
+    float time_min   = 1.0f;  // Mean time of an operation, drawn uniformly in [time_min, time_max]
+    float time_max   = 10.0f;
+    float energy_min = 1.0f;
+    float energy_max = 10.0f;
+
+    double correlation   = 0.0; // Correlation of the time and energy noise of every (operation, machine), -1..1
+    double noise         = 0.3; // Log-normal spread of every table entry around its mean
+    double job_skew      = 0.0; // Zipf exponent of the job lengths, 0 = every job the same length
+    double heterogeneity = 0.0; // Log-normal spread of the machine speed and power factors, 0 = identical machines
+};
+
+// false (and a message) when the parameters can't make a valid instance
+bool validateGeneratorParams(const GeneratorParams& params);
+
+// Tables are operation_types x machines, values rounded to one decimal like test/Eg*.txt.
+// Every job is a sorted list of distinct 1-based operations
+void generateInstance(const GeneratorParams& params, vvf& time, vvf& energy, vvi& jobs);
+
+// Text format of test/testcase_structure.txt
+bool writeInstanceFile(const std::string& path, const vvf& time, const vvf& energy, const vvi& jobs);
+
+#endif // INSTANCE_GENERATOR_H
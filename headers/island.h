@@ -0,0 +1,123 @@
+#ifndef ISLAND_H
+#define ISLAND_H
+
+#pragma once
+
+#include "config.h"
+#include "delta_eval.h"
+#include "migration_buffer.h"
+#include "nsgaII.h"
+#include "profiler.h"
+#include "rng.h"
+#include "thread_pool.h"
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+struct AdaptiveParams {
+    int crossover_prob;
+    int mutation_prob;
+};
+
+// Objectives of a whole population at a checkpoint. Islands are merged from these
+// once the run is over, so logging never stops them
+struct PopulationSnapshot{
+    int generation;
+    AdaptiveParams params;
+    std::array<std::vector<float>, NUM_POLICIES> times;
+    std::array<std::vector<float>, NUM_POLICIES> energies;
+};
+
+// One evolving population with its RNG, genes and buffers. The generational engine is a
+// single island, the island model runs several of them on their own threads
+class Island{
+private:
+    const Data& data;
+    const SchedulePlan& plan;
+    const RunConfig& config;
+    FitnessCache* fitness_cache;
+    SeedProfile& profile;
+    ThreadPool* pool; // Policies and individuals of a generation are spread over it, nullptr = serial
+    int lanes;
+
+    std::mt19937 gen;     // RngMode::MT19937
+    uint32_t stream_seed;  // RngMode::STREAMS, key of the island's streams
+    uint32_t stream_island;
+    int generation = 0;   // 0 while initializing
+
+    const int population_size;
+    GeneArena arena;
+    Population population;
+    Population offspring_population;
+    Population combined_population;
+    Population next_population;
+    Population newcomer; // Steady state: the child being inserted
+
+    std::vector<EvalScratch> lane_scratch;
+    PrefixCache prefix_cache;
+    std::vector<float> member_best; // Best makespan of every evaluated individual
+    std::array<FrontSet, NUM_POLICIES> front_sets;
+    std::vector<IndividualDelta> offspring_delta;
+    std::vector<std::vector<char>> lane_swap_mask;
+    std::vector<int> migrant_genes;
+
+    AdaptiveParams params = {80, 10};
+    float global_best_makespan = 1e9;
+    int gens_no_improve = 0;
+
+    float evaluateMember(Population& pop, int ind, const IndividualDelta* delta, int lane);
+    // Individuals [0, count) of pop, in parallel. Returns the best makespan among them
+    float evaluateMembers(Population& pop, int count, bool offspring);
+    void adaptParameters();
+    void trackImprovement(float current_gen_best);
+    RngStream stream(RngPhase phase, int slot) const;
+    // Crossover of two random parents into child1 and child2 (rows already acquired), then the mutations
+    template <typename Rng>
+    void breed(int child1, int child2, Rng& rng, std::vector<char>& swap_mask);
+    // Every pair of a generation, in parallel with RNG streams
+    void breedAll(int children);
+    void insertOffspring(int child);
+
+public:
+    // gen is the sequence of RngMode::MT19937, (seed, island) the key of the streams.
+    // extra_rows: arena rows for the migrants received in one migration
+    Island(const Data& data, const SchedulePlan& plan, const RunConfig& config, std::mt19937 gen, int seed, int island,
+           FitnessCache* fitness_cache, SeedProfile& profile, ThreadPool* pool = nullptr, int extra_rows = 0);
+
+    // Gen 0: random chromosomes, evaluated
+    void initialize();
+
+    // One generation of NSGA-II: a whole offspring population, merge and selection
+    void generationalStep();
+
+    // As many offspring as individuals, inserted one at a time: each one replaces, in every
+    // policy, the worst member (highest rank, lowest crowding distance) if it's better
+    void steadyStateStep();
+
+    // Rank 1 members with the largest crowding distance, migration_size per policy and buffer
+    void emigrate(const std::vector<MigrationBuffer*>& destinations);
+
+    // Every migrant replaces the worst member of its policy
+    void immigrate(const std::vector<MigrationBuffer*>& sources);
+
+    PopulationSnapshot snapshot(int generation) const;
+
+    Population& currentPopulation(){ return population; }
+    const GeneArena& genes() const{ return arena; }
+};
+
+// Steps shared by the engines. Rng is std::mt19937 or RngStream (instantiated in island.cpp)
+// Random genes into the rows ind already has
+template <typename Rng>
+void generateChromosome(const Data& data, GeneArena& arena, Population& population, int ind, Rng& gen);
+// The policies are sorted in parallel when a pool is given
+void sortPopulation(Population& population, SortMethod sort_method, std::array<FrontSet, NUM_POLICIES>& fronts,
+                    SeedProfile& profile, ThreadPool* pool = nullptr);
+template <typename Rng>
+void tournamentSelection(const Population& population, Population& next_population, int survivor, Rng& gen);
+template <typename Rng>
+void mutate(Population& offspring, int child, GeneArena& arena, Rng& gen, IndividualDelta& delta);
+
+#endif // ISLAND_H
@@ -0,0 +1,35 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Read-only view of a whole file. It's memory-mapped on POSIX systems, elsewhere
+// the file is read into a buffer once
+class MappedFile{
+private:
+    const char* bytes;
+    std::size_t length;
+    bool mapped;
+    bool opened;
+    std::vector<char> buffer; // Fallback storage when the file can't be mapped
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const;
+    const char* data() const;
+    std::size_t size() const;
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,61 @@
+#ifndef MIGRATION_BUFFER_H
+#define MIGRATION_BUFFER_H
+
+#pragma once
+
+#include "nsgaII.h"
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+// Chromosomes sent from one island to another, one buffer per edge of the topology.
+// Migration is synchronous: every island stops at the migration point, then they all
+// send and afterwards they all receive, so a buffer is never used by two threads at once.
+// Genes are copied into preallocated slots, so no allocation happens while the islands run
+class MigrationBuffer{
+private:
+    int gene_length;
+    size_t capacity; // Migrants of one migration
+    std::vector<int> genes;
+    std::vector<PolicyType> policies;
+    std::vector<Fitness> fitness;
+
+    size_t count = 0; // Migrants sent
+    size_t next  = 0; // Next migrant to receive
+
+public:
+    MigrationBuffer(int gene_length, size_t max_migrants)
+        : gene_length(gene_length), capacity(max_migrants),
+          genes(capacity * gene_length), policies(capacity), fitness(capacity){}
+
+    MigrationBuffer(const MigrationBuffer&) = delete;
+    MigrationBuffer& operator=(const MigrationBuffer&) = delete;
+
+    // false when the buffer is full, the migrant is dropped
+    bool push(PolicyType policy, const int* chromosome, const Fitness& value){
+        if(count == capacity) return false;
+
+        std::memcpy(genes.data() + count * gene_length, chromosome, gene_length * sizeof(int));
+        policies[count] = policy;
+        fitness[count]  = value;
+        ++count;
+        return true;
+    }
+
+    // Migrants in the order they were sent, the buffer is empty again once they're all taken
+    bool pop(PolicyType& policy, Fitness& value, int* chromosome){
+        if(next == count){
+            count = next = 0;
+            return false;
+        }
+
+        std::memcpy(chromosome, genes.data() + next * gene_length, gene_length * sizeof(int));
+        policy = policies[next];
+        value  = fitness[next];
+        ++next;
+        return true;
+    }
+};
+
+#endif // MIGRATION_BUFFER_H
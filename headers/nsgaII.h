@@ -1,9 +1,17 @@
 #ifndef NSGAII_H
 #define NSGAII_H
 
+#include "config.h"
 #include "individual.h"
 #include "policies.h"
+#include "population.h"
+#include "rng.h"
+#include "schedule_plan.h"
 
+#include <array>
+#include <cstdint>
+#include <random>
+#include <utility>
 #include <unordered_map>
 #include <string>
 
@@ -18,6 +26,127 @@ struct Gantt{
     //float energy;
 };
 
-void mainLoop(const Data& data, const std::unordered_map<PolicyType, vec_op>& policies_order, const std::string& instance_name);
+std::string policyToString(PolicyType policy);
+
+// Reusable buffers for the makespan evaluator, one per worker.
+// They only grow, so after the first evaluation no more heap allocations are made
+struct EvalScratch{
+    std::vector<float> job_end_time;
+    std::vector<float> machine_end_time;
+};
+
+// Makespan and the Gantt diagram of every machine
+std::pair<float, std::vector<std::vector<Gantt>>> totalTime(const PolicyPlan& plan, const int* chromosome);
+
+// Makespan only, no Gantt diagram is built
+float totalMakespan(const PolicyPlan& plan, const int* chromosome, EvalScratch& scratch);
+
+// Energy only
+float totalEnergy(const PolicyPlan& plan, const int* chromosome);
+
+// Both objectives of one chromosome
+struct Fitness{
+    float makespan;
+    float energy;
+};
+
+// Makespan and energy in a single pass over the chromosome
+Fitness evaluate(const PolicyPlan& plan, const int* chromosome, EvalScratch& scratch);
+
+class FitnessCache;
+
+// Evaluates the six policies of an individual and stores their fitness.
+// Chromosomes found in fitness_cache aren't evaluated again, new ones are added to it.
+// Returns the best makespan among them
+float evaluateIndividual(const SchedulePlan& plan, const GeneArena& arena, Population& population, int ind,
+EvalScratch& scratch, FitnessCache* fitness_cache = nullptr);
+
+// What the operators changed in one chromosome since it was copied from base_row.
+// Priorities before first_changed hold the same genes as base_row
+struct GeneDelta{
+    int base_row      = -1; // -1 = no base, evaluated from scratch
+    int first_changed = 0;
+};
+
+// One delta per policy of an individual, indexed by PolicyType
+using IndividualDelta = std::array<GeneDelta, NUM_POLICIES>;
+
+// Operators report the lowest priority they touched
+inline void markChanged(GeneDelta& delta, int position){
+    if(position < delta.first_changed) delta.first_changed = position;
+}
+
+// Genetic operators, children and mutated chromosomes report their changes in the deltas.
+// Rng is std::mt19937 or RngStream (instantiated in nsgaII.cpp). Children write into the
+// rows they already have (GeneArena::acquireIndividual).
+// swap_mask is the crossover's per-gene buffer, kept by the caller so no call allocates
+template <typename Rng>
+void crossover(const Population& parents, int parent1, int parent2, Population& offspring, int child1, int child2,
+GeneArena& arena, Rng& gen, int current_crossover_prob, IndividualDelta& delta1, IndividualDelta& delta2,
+std::vector<char>& swap_mask);
+template <typename Rng>
+void interChrome(Population& population, int ind, Rng& gen, IndividualDelta& delta);
+template <typename Rng>
+void equitativeExchange(Population& population, int ind, GeneArena& arena, Rng& gen, IndividualDelta& delta);
+template <typename Rng>
+void circular(Population& population, int ind, GeneArena& arena, Rng& gen, IndividualDelta& delta);
+
+// Fronts of a non-dominated sort stored flat, front f is order[starts[f], starts[f + 1]).
+// Every buffer keeps its capacity, so sorting a population of the same size again
+// (and its crowding distance) allocates nothing
+struct FrontSet{
+    std::vector<int> order;  // Indices, front after front
+    std::vector<int> starts; // numFronts() + 1 offsets
+
+    // Scratch of the sorts
+    std::vector<int> domination_count;
+    std::vector<std::pair<int, int>> dominations; // (dominating, dominated) in the order they're found
+    std::vector<int> dominated;                   // Grouped by dominating individual
+    std::vector<int> dominated_start;
+    std::vector<int> by_time;
+    std::vector<int> front_tail;
+
+    // Scratch of the crowding distance, (objective, individual)
+    std::vector<std::pair<float, int>> keys;
+
+    // Room for populations of up to size individuals. The domination pairs of the reference
+    // sort (up to size^2 / 2) are only reserved for small populations, larger ones grow
+    void reserve(int size){
+        size_t pairs = static_cast<size_t>(size) * (size - 1) / 2;
+        if(pairs <= (1u << 16)) dominations.reserve(pairs);
+        order.reserve(size);
+        starts.reserve(size + 1);
+        domination_count.reserve(size);
+        dominated_start.reserve(size + 1);
+        by_time.reserve(size);
+        front_tail.reserve(size);
+        keys.reserve(size);
+    }
+
+    int numFronts() const{ return static_cast<int>(starts.size()) - 1; }
+    int* front(int f){ return order.data() + starts[f]; }
+    int frontSize(int f) const{ return starts[f + 1] - starts[f]; }
+};
+
+// Both set the rank of every individual for the policy and return the fronts (0 = rank 1).
+// They give the same ranks, only the order of the indices inside a front may differ
+void fastNonDominatedSort(Population& population, const PolicyType& policy, FrontSet& fronts);
+void sweepNonDominatedSort(Population& population, const PolicyType& policy, FrontSet& fronts);
+void nonDominatedSort(Population& population, const PolicyType& policy, SortMethod method, FrontSet& fronts);
+
+// Same fronts as nested vectors
+std::vector<std::vector<int>> fastNonDominatedSort(Population& population, const PolicyType& policy);
+std::vector<std::vector<int>> sweepNonDominatedSort(Population& population, const PolicyType& policy);
+std::vector<std::vector<int>> nonDominatedSort(Population& population, const PolicyType& policy, SortMethod method);
+
+// Crowding distance of the individuals of one front, the indices are left sorted by energy.
+// (objective, index) keys are sorted instead of the indices, keys only grows
+void calculateCrowdingDistance(Population& population, int* front, int size, const PolicyType& policy,
+                               std::vector<std::pair<float, int>>& keys);
+void calculateCrowdingDistance(Population& population, std::vector<int>& front, const PolicyType& policy);
+
+// Runs every seed of the config, results go to config.output_dir/instance_name
+void mainLoop(const Data& data, const std::unordered_map<PolicyType, vec_op>& policies_order, const std::string& instance_name,
+const RunConfig& config);
 
 #endif // NSGAII_H
\ No newline at end of file
@@ -0,0 +1,91 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// CSV text built in memory, numbers are formatted with to_chars (no iostreams).
+// Floats look like the default ostream output (%g, 6 significant digits)
+class CsvBuffer{
+private:
+    std::string text;
+    bool row_start = true;
+    char delimiter;
+
+    void separator();
+
+public:
+    explicit CsvBuffer(char delimiter = ',') : delimiter(delimiter){}
+
+    CsvBuffer& add(int value);
+    CsvBuffer& add(uint64_t value);
+    CsvBuffer& add(float value);
+    CsvBuffer& add(double value); // 7 significant digits, the precision of the float objectives
+    CsvBuffer& add(std::string_view value);
+    void endRow();
+
+    // Raw text, like a header line
+    void append(std::string_view raw);
+
+    const std::string& str() const{ return text; }
+    size_t size() const{ return text.size(); }
+    void clear();
+};
+
+// Output file with a large write buffer, data reaches the disk in big blocks
+class BufferedFile{
+private:
+    std::FILE* file = nullptr;
+    std::vector<char> buffer;
+    size_t used = 0;
+    uint64_t written = 0;
+    bool failed = false;
+
+public:
+    explicit BufferedFile(size_t capacity = 1 << 20);
+    ~BufferedFile();
+
+    BufferedFile(const BufferedFile&) = delete;
+    BufferedFile& operator=(const BufferedFile&) = delete;
+
+    bool open(const std::string& path);
+    bool isOpen() const;
+    // false if something couldn't be written
+    bool close();
+
+    void write(std::string_view data);
+    // The buffer goes to the stdio buffer
+    void flush();
+    // The buffer reaches the OS, readers of the file see everything written so far
+    void sync();
+
+    // Bytes written so far, buffered ones included (offsets for the packed Gantt index)
+    uint64_t bytesWritten() const;
+};
+
+// Rows of concurrent seeds written in seed order, same file as a serial run. Rows of the
+// earliest unfinished seed are written and synced at once, the ones of later seeds wait
+// until every seed before them has finished
+class SeedOrderedWriter{
+private:
+    BufferedFile& file;
+    std::mutex mutex;
+    std::vector<std::string> pending; // Per seed, rows waiting for an earlier seed
+    std::vector<char> finished;
+    size_t head = 0; // Earliest unfinished seed
+
+public:
+    SeedOrderedWriter(BufferedFile& file, size_t num_seeds);
+
+    void write(size_t seed_index, std::string_view rows);
+    // No more rows of the seed
+    void finish(size_t seed_index);
+};
+
+#endif // OUTPUT_H
@@ -27,4 +27,11 @@ vec_op RR_FIFO(const int& tasks, const vvi& jobs);
 vec_op RR_LTP (const int& tasks, const vvi& jobs, const vvf& time);
 vec_op RR_ECA (const int& tasks, const vvi& jobs, const vvf& energy);
 
+// Same orderings reading the tables of a loaded instance (time, or energy for RR_ECA)
+class Data;
+vec_op LTP    (const int& tasks, const vvi& jobs, const Data& data);
+vec_op STP    (const int& tasks, const vvi& jobs, const Data& data);
+vec_op RR_LTP (const int& tasks, const vvi& jobs, const Data& data);
+vec_op RR_ECA (const int& tasks, const vvi& jobs, const Data& data);
+
 #endif // POLICIES_H
\ No newline at end of file
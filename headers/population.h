@@ -0,0 +1,85 @@
+#ifndef POPULATION_H
+#define POPULATION_H
+
+#pragma once
+
+#include "individual.h"
+
+#include <vector>
+
+class Population;
+
+// Every chromosome of the run lives in one contiguous block of rows (one row = one
+// chromosome of gene_length machines). Populations only keep row numbers, so selecting
+// or merging individuals never copies genes.
+class GeneArena{
+private:
+    int gene_length;
+    std::vector<int> genes; // max_rows x gene_length
+    std::vector<int> free_rows;
+    std::vector<char> in_use;
+
+public:
+    GeneArena(int gene_length, int max_rows);
+
+    int geneLength() const;
+
+    // A free row, its genes are garbage until written
+    int acquire();
+    // A free row for every policy of ind, in policy order
+    void acquireIndividual(Population& population, int ind);
+
+    int* row(int r);
+    const int* row(int r) const;
+
+    // Every row not referenced by keep goes back to the free list
+    void collect(const Population& keep);
+};
+
+// Structure of arrays population. Values are stored policy-major, (policy, individual)
+// is at policy * capacity + individual, so every policy has contiguous objective arrays.
+class Population{
+private:
+    int capacity;
+    int count;
+
+    std::vector<int> rows; // GeneArena row of each chromosome
+    std::vector<float> time_fitness;
+    std::vector<float> energy_fitness;
+    std::vector<float> crowding_distance;
+    std::vector<int> rank; // Dominance level
+
+public:
+    explicit Population(int capacity);
+
+    int size() const;
+    void resize(int n); // n <= capacity, new individuals aren't initialized
+
+    int index(PolicyType policy, int ind) const{
+        return static_cast<int>(policy) * capacity + ind;
+    }
+
+    int& row(PolicyType policy, int ind){ return rows[index(policy, ind)]; }
+    int row(PolicyType policy, int ind) const{ return rows[index(policy, ind)]; }
+
+    // Contiguous arrays of size() values for one policy
+    float* times(PolicyType policy){ return time_fitness.data() + index(policy, 0); }
+    float* energies(PolicyType policy){ return energy_fitness.data() + index(policy, 0); }
+    float* crowding(PolicyType policy){ return crowding_distance.data() + index(policy, 0); }
+    int* ranks(PolicyType policy){ return rank.data() + index(policy, 0); }
+    const float* times(PolicyType policy) const{ return time_fitness.data() + index(policy, 0); }
+    const float* energies(PolicyType policy) const{ return energy_fitness.data() + index(policy, 0); }
+    const float* crowding(PolicyType policy) const{ return crowding_distance.data() + index(policy, 0); }
+    const int* ranks(PolicyType policy) const{ return rank.data() + index(policy, 0); }
+
+    // Copies the (row, fitness, rank, CD) of one policy of src's individual
+    void copyPolicy(PolicyType policy, int ind, const Population& src, int src_ind);
+
+    // This population becomes a followed by b, only row numbers and fitness are copied
+    void assignMerged(const Population& a, const Population& b);
+
+    // AoS copy of an individual, mostly for debugging and exports
+    Individual extract(const GeneArena& arena, int ind) const;
+};
+
+#endif // POPULATION_H
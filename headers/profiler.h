@@ -0,0 +1,89 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Phases of a seed timed by the profiler. Build with -DNO_PROFILING to compile
+// every timer and counter out
+enum class Phase{
+    INITIALIZATION, // Gen 0 chromosomes and buffers
+    EVALUATION,     // Fitness of gen 0 and of every offspring
+    SORTING,        // Non-dominated sorting
+    CROWDING,       // Crowding distance
+    VARIATION,      // Crossover and mutations
+    SELECTION,      // Merge of parents and offspring, tournament, arena collection
+    CHECKPOINT,     // Fronts and quality indicators of the checkpoints
+    GANTT,          // Final fronts, plus the export thread rebuilding and writing their schedules
+    OUTPUT,         // Merge of the seed into the shared files of the instance
+};
+constexpr int NUM_PHASES = 9;
+
+const char* phaseName(Phase phase);
+
+// Time and counters of one seed
+struct SeedProfile{
+    int seed = 0;
+    std::array<uint64_t, NUM_PHASES> phase_ns{};
+    std::array<uint64_t, NUM_PHASES> phase_calls{};
+    uint64_t evaluations = 0; // Chromosomes (policy, individual) evaluated or found in the cache
+    uint64_t total_ns    = 0; // Whole seed, from the worker that ran it
+
+    double seconds(Phase phase) const{ return phase_ns[static_cast<int>(phase)] * 1e-9; }
+    double evaluationsPerSecond() const{ return total_ns ? evaluations / (total_ns * 1e-9) : 0.0; }
+};
+
+// Times and counters of from are added to into (threads that worked for the same seed)
+void mergeProfile(SeedProfile& into, const SeedProfile& from);
+
+// Adds the time of its scope to a phase of the profile
+class ScopedTimer{
+private:
+    SeedProfile& profile;
+    int phase;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    ScopedTimer(SeedProfile& profile, Phase phase)
+        : profile(profile), phase(static_cast<int>(phase)), start(std::chrono::steady_clock::now()){}
+
+    ~ScopedTimer(){
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        profile.phase_ns[phase] += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        ++profile.phase_calls[phase];
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef NO_PROFILING
+#define PROFILE_SCOPE(profile, phase) ((void)(profile))
+#define PROFILE_COUNT(profile, counter, amount) ((void)(profile))
+#else
+#define PROFILE_SCOPE(profile, phase) ScopedTimer PROFILE_CONCAT(profile_timer_, __LINE__)(profile, phase)
+#define PROFILE_COUNT(profile, counter, amount) ((profile).counter += (amount))
+#endif
+
+// true when the timers are compiled in
+constexpr bool profilingEnabled(){
+#ifdef NO_PROFILING
+    return false;
+#else
+    return true;
+#endif
+}
+
+// profile.csv: one row per seed (seconds per phase, evaluations and evaluations/second)
+// plus a total row with the wall time of the instance
+bool writeProfile(const std::string& path, const std::vector<SeedProfile>& profiles, double wall_seconds);
+
+#endif // PROFILER_H
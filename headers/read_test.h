@@ -3,11 +3,18 @@
 
 #pragma once
 
+#include "individual.h"
+
 #include <vector>
 #include <fstream>
+#include <string>
 
 std::vector<std::vector<float>> loadTime(std::ifstream& f);
 std::vector<std::vector<float>> loadEnergy(std::ifstream& f);
 std::vector<std::vector<int>> loadWork(std::ifstream& f);
 
+// Whole instance in one pass: the file is memory-mapped and parsed with from_chars straight
+// into Data's tables. Errors are reported as path:line:column. Same values as the loaders above
+bool loadInstanceFile(const std::string& path, Data& data, std::vector<std::vector<int>>& jobs);
+
 #endif //READ_TEST_H
\ No newline at end of file
@@ -0,0 +1,92 @@
+#ifndef RNG_H
+#define RNG_H
+
+#pragma once
+
+#include "individual.h"
+
+#include <array>
+#include <cstdint>
+#include <random>
+
+// What a stream is drawn for inside one generation, part of its counter
+enum class RngPhase : uint32_t{
+    INITIALIZATION, // Gen 0 chromosomes, one stream per individual
+    VARIATION,      // Parents, crossover and mutations, one stream per pair of children
+    SELECTION       // Tournaments, one stream per survivor
+};
+
+// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", 2011).
+// Every 128-bit counter is encrypted on its own, so a stream is fully defined by its key
+// (seed, island) and the fixed words of its counter (generation, phase, slot, child, policy):
+// streams don't depend on which thread draws them or on what was drawn before.
+// It's a UniformRandomBitGenerator, the std distributions take it like std::mt19937
+class RngStream{
+public:
+    using result_type = uint32_t;
+
+    RngStream(uint32_t seed, uint32_t island, uint32_t generation, RngPhase phase, uint32_t slot)
+        : key{seed, island}, counter{0, generation, static_cast<uint32_t>(phase) << 16, slot}{}
+
+    static constexpr result_type min(){ return 0; }
+    static constexpr result_type max(){ return UINT32_MAX; }
+
+    result_type operator()(){
+        if(used == 4){
+            block = encrypt(counter);
+            ++counter[0];
+            used = 0;
+        }
+        return block[used++];
+    }
+
+    // Independent stream of one child of the slot's pair, its mutations draw from it
+    RngStream child(int child) const{
+        return derived((static_cast<uint32_t>(child) + 1) << 8);
+    }
+
+    // Independent stream of one policy, for the operators that treat every policy apart
+    RngStream policy(PolicyType policy) const{
+        return derived(static_cast<uint32_t>(policy) + 1);
+    }
+
+private:
+    std::array<uint32_t, 2> key;
+    std::array<uint32_t, 4> counter; // Block, generation, phase << 16 | (child + 1) << 8 | policy + 1, slot
+    std::array<uint32_t, 4> block{};
+    int used = 4; // Words of block already returned
+
+    // Same stream identity plus the given bits of the third counter word, from its first block
+    RngStream derived(uint32_t bits) const{
+        RngStream stream(*this);
+        stream.counter[0] = 0;
+        stream.counter[2] |= bits;
+        stream.used = 4;
+        return stream;
+    }
+
+    std::array<uint32_t, 4> encrypt(std::array<uint32_t, 4> x) const{
+        std::array<uint32_t, 2> k = key;
+        for(int round = 0; round < 10; ++round){
+            uint64_t product0 = static_cast<uint64_t>(0xD2511F53u) * x[0];
+            uint64_t product1 = static_cast<uint64_t>(0xCD9E8D57u) * x[2];
+            x = {static_cast<uint32_t>(product1 >> 32) ^ x[1] ^ k[0], static_cast<uint32_t>(product1),
+                 static_cast<uint32_t>(product0 >> 32) ^ x[3] ^ k[1], static_cast<uint32_t>(product0)};
+            k[0] += 0x9E3779B9u;
+            k[1] += 0xBB67AE85u;
+        }
+        return x;
+    }
+};
+
+// Generator of one child's mutations: its own stream with RngStream, the shared sequence
+// with std::mt19937
+inline std::mt19937& childGenerator(std::mt19937& gen, int){ return gen; }
+inline RngStream childGenerator(const RngStream& gen, int child){ return gen.child(child); }
+
+// Generator of one policy inside the operators: its own stream with RngStream, the
+// shared sequence with std::mt19937 (which keeps the draws of the serial runs)
+inline std::mt19937& policyGenerator(std::mt19937& gen, PolicyType){ return gen; }
+inline RngStream policyGenerator(const RngStream& gen, PolicyType policy){ return gen.policy(policy); }
+
+#endif // RNG_H
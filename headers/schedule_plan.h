@@ -0,0 +1,53 @@
+#ifndef SCHEDULE_PLAN_H
+#define SCHEDULE_PLAN_H
+
+#pragma once
+
+#include "individual.h"
+#include "policies.h"
+
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+// Everything an evaluation of one policy reads, in priority order
+struct PolicyPlan{
+    int num_ops      = 0;
+    int num_jobs     = 0;
+    int num_machines = 0;
+
+    std::vector<int> jobs;       // Job of the operation at every priority
+    std::vector<int> operations; // Operation (row of the instance tables) at every priority
+    std::vector<int> cost_rows;  // Row of costs read at every priority
+    const TimeEnergy* costs = nullptr; // Rows of num_machines (time, energy) pairs
+
+    const TimeEnergy* costRow(int priority) const{
+        return costs + static_cast<size_t>(cost_rows[priority]) * num_machines;
+    }
+};
+
+// The six orderings of an instance compiled once and shared by every seed and thread.
+// When they fit in max_cost_bytes the cost rows are copied in priority order, one per
+// priority and policy, so an evaluation reads them front to back. Otherwise the plans
+// read the rows of the instance table
+class SchedulePlan{
+private:
+    std::array<PolicyPlan, NUM_POLICIES> plans;
+    std::vector<TimeEnergy> ordered_costs; // NUM_POLICIES x num_ops x num_machines, or empty
+
+public:
+    SchedulePlan(const Data& data, const std::unordered_map<PolicyType, vec_op>& policies_order, size_t max_cost_bytes);
+
+    // The plans point into ordered_costs
+    SchedulePlan(const SchedulePlan&) = delete;
+    SchedulePlan& operator=(const SchedulePlan&) = delete;
+
+    const PolicyPlan& operator[](PolicyType policy) const{ return plans[static_cast<int>(policy)]; }
+    const PolicyPlan& operator[](int policy) const{ return plans[policy]; }
+
+    bool priorityOrdered() const{ return !ordered_costs.empty(); }
+    size_t costBytes() const{ return ordered_costs.size() * sizeof(TimeEnergy); }
+};
+
+#endif // SCHEDULE_PLAN_H
@@ -0,0 +1,101 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Growable ring of tasks. Once it has been as long as it gets, pushing and popping
+// don't allocate (std::deque allocates a block every few tasks)
+class TaskQueue{
+private:
+    std::vector<std::function<void()>> slots;
+    size_t head  = 0;
+    size_t count = 0;
+
+public:
+    bool empty() const{ return count == 0; }
+    void pushBack(std::function<void()> task);
+    std::function<void()> popBack();
+    std::function<void()> popFront();
+};
+
+// Fixed size pool of workers with work stealing. Every worker has its own queue: tasks
+// submitted from a worker go to the back of its queue and it takes them back from there,
+// idle workers steal from the front of the others. Tasks submitted from outside the pool
+// wait in a shared queue
+class ThreadPool{
+private:
+    struct WorkerQueue{
+        std::mutex mutex;
+        TaskQueue tasks;
+    };
+
+    // Shared state of one parallelFor, recycled by the pool
+    struct Loop;
+    using LoopBody = void (*)(void* context, int index, int lane);
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkerQueue>> local_queues;
+    TaskQueue shared_tasks;
+
+    std::mutex queue_mutex; // shared_tasks, pending increments and sleeping workers
+    std::condition_variable condition;
+    std::atomic<long> pending{0}; // Tasks in any queue
+    bool stopping;
+
+    std::mutex loop_mutex;
+    std::vector<std::unique_ptr<Loop>> loops;
+    std::vector<Loop*> free_loops;
+
+    void push(std::function<void()> task);
+    bool tryPop(int worker, std::function<void()>& task);
+    void workerLoop(int worker);
+
+    Loop* acquireLoop();
+    void releaseLoop(Loop* loop);
+    void runLoop(Loop* loop, int lane);
+    void helpLoop(Loop* loop);
+    void parallelFor(int count, int max_lanes, LoopBody body, void* context);
+
+public:
+    // 0 threads means "use every core available"
+    explicit ThreadPool(unsigned int num_threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned int size() const;
+
+    template <typename F>
+    auto submit(F&& task) -> std::future<decltype(task())>{
+        using R = decltype(task());
+        auto packaged = std::make_shared<std::packaged_task<R()>>(std::forward<F>(task));
+        std::future<R> result = packaged->get_future();
+        push([packaged](){ (*packaged)(); });
+        return result;
+    }
+
+    // body(index, lane) for every index in [0, count), on at most max_lanes threads. The caller
+    // is lane 0 and works too, so it can be called from a task without blocking a worker;
+    // lanes are < max_lanes and a lane never runs two indices at the same time.
+    // Nothing is allocated once the pool has served a loop of as many lanes
+    template <typename F>
+    void parallelFor(int count, int max_lanes, F&& body){
+        using Body = std::remove_reference_t<F>;
+        parallelFor(count, max_lanes, [](void* context, int index, int lane){
+            (*static_cast<Body*>(context))(index, lane);
+        }, const_cast<void*>(static_cast<const void*>(&body)));
+    }
+};
+
+#endif // THREAD_POOL_H
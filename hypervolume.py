@@ -1,5 +1,4 @@
 import pandas as pd
-from pymoo.indicators.hv import HV
 import numpy as np
 import warnings
 import sys
@@ -10,13 +9,19 @@ import os
 # tal vez necesites aumentar este punto de referencia (ej. [500.0, 500.0]).
 ref_point = np.array([1000.0, 1000.0]) 
 
-hv_calculator = HV(ref_point=ref_point, normalize=False)
+hv_calculator = None
 
 policies_order = ["FIFO", "LTP", "STP", "RR_FIFO", "RR_LTP", "RR_ECA"]
 stats_order = ['min', 'max', 'Prom (desv)']
 instances = ["Eg1", "Eg2", "Eg3"]
 
 def calculate_hv(group):
+    global hv_calculator
+    if hv_calculator is None:
+        # Solo hace falta pymoo si el C++ no escribió quality_indicators.csv
+        from pymoo.indicators.hv import HV
+        hv_calculator = HV(ref_point=ref_point, normalize=False)
+
     # Seleccionamos solo las columnas de fitness
     points = group[['Time_Fitness', 'Energy_Fitness']].values
     if points.shape[0] == 0:
@@ -30,29 +35,34 @@ for instance in instances:
     
     # Rutas dinámicas por instancia
     input_file = f"results/{instance}/all_checkpoint_fronts.csv"
+    indicators_file = f"results/{instance}/quality_indicators.csv"
     output_file = f"results/{instance}/hypervolume_report.csv"
 
-    if not os.path.exists(input_file):
+    # El C++ ya calcula el HV en cada checkpoint (punto de referencia según la instancia)
+    if os.path.exists(indicators_file):
+        hv_data = pd.read_csv(indicators_file)[['Seed', 'Generation', 'Policy', 'Hypervolume']]
+    elif not os.path.exists(input_file):
         print(f"  [AVISO] No se encontró el archivo: {input_file}. Saltando...")
         continue
 
-    try:
-        df = pd.read_csv(input_file)
-    except Exception as e:
-        print(f"  [ERROR] Al leer CSV: {e}")
-        continue
+    else:
+        try:
+            df = pd.read_csv(input_file)
+        except Exception as e:
+            print(f"  [ERROR] Al leer CSV: {e}")
+            continue
 
-    # Filtrar solo el primer frente (Rank 1)
-    df_pareto = df[df['Rank'] == 1].copy()
+        # Filtrar solo el primer frente (Rank 1)
+        df_pareto = df[df['Rank'] == 1].copy()
 
-    if df_pareto.empty:
-        print(f"  [AVISO] El CSV de {instance} no contiene soluciones con 'Rank == 1'.")
-        continue
+        if df_pareto.empty:
+            print(f"  [AVISO] El CSV de {instance} no contiene soluciones con 'Rank == 1'.")
+            continue
 
-    # Calcular HV agrupando por Semilla, Generación y Política
-    # Esto nos da un valor de HV por cada "punto" en el tiempo de cada ejecución
-    hv_data = df_pareto.groupby(['Seed', 'Generation', 'Policy']).apply(calculate_hv)
-    hv_data = hv_data.reset_index(name='Hypervolume')
+        # Calcular HV agrupando por Semilla, Generación y Política
+        # Esto nos da un valor de HV por cada "punto" en el tiempo de cada ejecución
+        hv_data = df_pareto.groupby(['Seed', 'Generation', 'Policy']).apply(calculate_hv)
+        hv_data = hv_data.reset_index(name='Hypervolume')
 
     # Calcular estadísticas (Promedio y Desviación) sobre las 30 semillas
     with warnings.catch_warnings():
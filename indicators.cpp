@@ -0,0 +1,98 @@
+#include "headers/indicators.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static double distance(const ObjectivePoint& a, const ObjectivePoint& b){
+    return std::hypot(a.time - b.time, a.energy - b.energy);
+}
+
+static void sortByTime(std::vector<ObjectivePoint>& points){
+    std::sort(points.begin(), points.end(), [](const ObjectivePoint& a, const ObjectivePoint& b){
+        if(a.time != b.time) return a.time < b.time;
+        return a.energy < b.energy;
+    });
+}
+
+std::vector<ObjectivePoint> nonDominatedPoints(std::vector<ObjectivePoint> points){
+    sortByTime(points);
+
+    // Sorted by time, a point survives only if it lowers the best energy seen so far
+    std::vector<ObjectivePoint> front;
+    for(const ObjectivePoint& point : points){
+        if(front.empty() || point.energy < front.back().energy) front.push_back(point);
+    }
+    return front;
+}
+
+double hypervolume(std::vector<ObjectivePoint> front, const ObjectivePoint& reference_point){
+    sortByTime(front);
+
+    double volume = 0.0;
+    double best_energy = reference_point.energy;
+    for(const ObjectivePoint& point : front){
+        if(point.time >= reference_point.time) break;
+        if(point.energy >= best_energy) continue; // Dominated (or outside the box)
+
+        // Strip between this point and the previous best energy
+        volume += (reference_point.time - point.time) * (best_energy - point.energy);
+        best_energy = point.energy;
+    }
+    return volume;
+}
+
+double invertedGenerationalDistance(const std::vector<ObjectivePoint>& front, const std::vector<ObjectivePoint>& reference_front){
+    if(front.empty() || reference_front.empty()) return std::numeric_limits<double>::infinity();
+
+    double total = 0.0;
+    for(const ObjectivePoint& reference : reference_front){
+        double closest = std::numeric_limits<double>::infinity();
+        for(const ObjectivePoint& point : front) closest = std::min(closest, distance(point, reference));
+        total += closest;
+    }
+    return total / reference_front.size();
+}
+
+double spread(std::vector<ObjectivePoint> front, const std::vector<ObjectivePoint>& reference_front){
+    front = nonDominatedPoints(front);
+    if(front.empty()) return 1.0;
+
+    // Distance to the extremes of the reference front (time-best and energy-best)
+    double d_first = 0.0, d_last = 0.0;
+    if(!reference_front.empty()){
+        auto extremes = std::minmax_element(reference_front.begin(), reference_front.end(),
+        [](const ObjectivePoint& a, const ObjectivePoint& b){
+            return a.time < b.time;
+        });
+        d_first = distance(front.front(), *extremes.first);
+        d_last  = distance(front.back(), *extremes.second);
+    }
+
+    size_t gaps = front.size() - 1;
+    double mean_gap = 0.0;
+    for(size_t i = 0; i < gaps; ++i) mean_gap += distance(front[i], front[i + 1]);
+    if(gaps > 0) mean_gap /= gaps;
+
+    double deviation = 0.0;
+    for(size_t i = 0; i < gaps; ++i) deviation += std::fabs(distance(front[i], front[i + 1]) - mean_gap);
+
+    double denominator = d_first + d_last + gaps * mean_gap;
+    if(denominator == 0.0) return 0.0;
+    return (d_first + d_last + deviation) / denominator;
+}
+
+double additiveEpsilon(const std::vector<ObjectivePoint>& front, const std::vector<ObjectivePoint>& reference_front){
+    if(front.empty()) return std::numeric_limits<double>::infinity();
+
+    double epsilon = -std::numeric_limits<double>::infinity();
+    for(const ObjectivePoint& reference : reference_front){
+        double best_shift = std::numeric_limits<double>::infinity();
+        for(const ObjectivePoint& point : front){
+            double shift = std::max(point.time - reference.time, point.energy - reference.energy);
+            best_shift = std::min(best_shift, shift);
+        }
+        epsilon = std::max(epsilon, best_shift);
+    }
+    return reference_front.empty() ? 0.0 : epsilon;
+}
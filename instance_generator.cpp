@@ -0,0 +1,154 @@
+#include "headers/instance_generator.h"
+#include "headers/output.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+bool validateGeneratorParams(const GeneratorParams& params){
+    int types = params.operation_types > 0 ? params.operation_types : params.operations;
+    const char* error = nullptr;
+
+    if(params.operations < 1 || params.machines < 1 || params.jobs < 1) error = "operations, machines and jobs must be positive";
+    else if(params.jobs > params.operations) error = "every job needs at least one operation";
+    else if(static_cast<long long>(types) * params.jobs < params.operations) error = "not enough operation types for the jobs";
+    else if(params.time_min <= 0 || params.time_max < params.time_min) error = "invalid time range";
+    else if(params.energy_min <= 0 || params.energy_max < params.energy_min) error = "invalid energy range";
+    else if(params.correlation < -1.0 || params.correlation > 1.0) error = "correlation must be in [-1, 1]";
+    else if(params.noise < 0 || params.job_skew < 0 || params.heterogeneity < 0) error = "noise, skew and heterogeneity can't be negative";
+
+    if(error) std::cerr << "Invalid generator parameters: " << error << "\n";
+    return error == nullptr;
+}
+
+// One decimal, and never 0 (a zero time breaks nothing, but no real machine has it)
+static float roundValue(double value){
+    return std::max(0.1f, static_cast<float>(std::round(value * 10.0) / 10.0));
+}
+
+// Zipf weights spread over the jobs, every job keeps at least one operation and at most max_length
+static std::vector<int> jobLengths(const GeneratorParams& params, int max_length, std::mt19937_64& gen){
+    std::vector<double> weight(params.jobs);
+    for(int j = 0; j < params.jobs; ++j) weight[j] = std::pow(j + 1.0, -params.job_skew);
+    std::shuffle(weight.begin(), weight.end(), gen);
+    double total_weight = std::accumulate(weight.begin(), weight.end(), 0.0);
+
+    std::vector<int> length(params.jobs);
+    int assigned = 0;
+    for(int j = 0; j < params.jobs; ++j){
+        double share = params.operations * weight[j] / total_weight;
+        length[j] = std::clamp(static_cast<int>(share), 1, max_length);
+        assigned += length[j];
+    }
+
+    // Rounding leftovers, one operation at a time over the jobs that can take (or give) it
+    for(int j = 0; assigned < params.operations; j = (j + 1) % params.jobs){
+        if(length[j] < max_length){
+            ++length[j];
+            ++assigned;
+        }
+    }
+    for(int j = 0; assigned > params.operations; j = (j + 1) % params.jobs){
+        if(length[j] > 1){
+            --length[j];
+            --assigned;
+        }
+    }
+    return length;
+}
+
+void generateInstance(const GeneratorParams& params, vvf& time, vvf& energy, vvi& jobs){
+    std::mt19937_64 gen(params.seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    const int types = params.operation_types > 0 ? params.operation_types : params.operations;
+
+    // Machines: a speed and a power factor each
+    std::vector<double> speed(params.machines), power(params.machines);
+    for(int m = 0; m < params.machines; ++m){
+        speed[m] = std::exp(params.heterogeneity * normal(gen));
+        power[m] = std::exp(params.heterogeneity * normal(gen));
+    }
+
+    // Operations: a mean time and energy, then correlated noise on every machine
+    std::uniform_real_distribution<double> mean_time(params.time_min, params.time_max);
+    std::uniform_real_distribution<double> mean_energy(params.energy_min, params.energy_max);
+    const double independent = std::sqrt(1.0 - params.correlation * params.correlation);
+
+    time.assign(types, std::vector<float>(params.machines));
+    energy.assign(types, std::vector<float>(params.machines));
+    for(int op = 0; op < types; ++op){
+        double base_time   = mean_time(gen);
+        double base_energy = mean_energy(gen);
+        for(int m = 0; m < params.machines; ++m){
+            double z_time   = normal(gen);
+            double z_energy = params.correlation * z_time + independent * normal(gen);
+            time[op][m]   = roundValue(base_time * speed[m] * std::exp(params.noise * z_time));
+            energy[op][m] = roundValue(base_energy * power[m] * std::exp(params.noise * z_energy));
+        }
+    }
+
+    // Jobs
+    std::vector<int> length = jobLengths(params, types, gen);
+    jobs.assign(params.jobs, {});
+
+    if(params.operation_types <= 0){
+        // Every operation belongs to exactly one job
+        std::vector<int> ops(types);
+        std::iota(ops.begin(), ops.end(), 1);
+        std::shuffle(ops.begin(), ops.end(), gen);
+        int next = 0;
+        for(int j = 0; j < params.jobs; ++j){
+            jobs[j].assign(ops.begin() + next, ops.begin() + next + length[j]);
+            next += length[j];
+        }
+    }else{
+        // Jobs pick distinct operations among the shared types (Floyd's sampling)
+        std::vector<char> taken(types, 0);
+        for(int j = 0; j < params.jobs; ++j){
+            for(int r = types - length[j]; r < types; ++r){
+                int op = std::uniform_int_distribution<int>(0, r)(gen);
+                if(taken[op]) op = r;
+                taken[op] = 1;
+                jobs[j].push_back(op + 1);
+            }
+            for(int op : jobs[j]) taken[op - 1] = 0;
+        }
+    }
+    for(auto& job : jobs) std::sort(job.begin(), job.end());
+}
+
+static void appendTable(CsvBuffer& out, const vvf& table){
+    out.add(static_cast<int>(table.size())).add(static_cast<int>(table.empty() ? 0 : table[0].size()));
+    out.endRow();
+    for(const auto& row : table){
+        for(float value : row) out.add(value);
+        out.endRow();
+    }
+}
+
+bool writeInstanceFile(const std::string& path, const vvf& time, const vvf& energy, const vvi& jobs){
+    // The text format is space separated
+    CsvBuffer text(' ');
+    appendTable(text, time);
+    appendTable(text, energy);
+    text.add(static_cast<int>(jobs.size()));
+    text.endRow();
+    for(const auto& job : jobs){
+        for(int op : job) text.add(op);
+        text.endRow();
+    }
+
+    BufferedFile file;
+    if(!file.open(path)){
+        std::cerr << "Error: Could'nt write the instance: " << path << "\n";
+        return false;
+    }
+    file.write(text.str());
+    if(!file.close()){
+        std::cerr << "Error: Could'nt write the instance: " << path << "\n";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,414 @@
+#include "headers/island.h"
+
+#include <algorithm>
+#include <utility>
+
+// Generate random chromosomes for the first(s) generation(s)
+template <typename Rng>
+void generateChromosome(const Data& data, GeneArena& arena, Population& population, int ind, Rng& gen){
+    int total_ops    = data.getNumTasks();
+    int num_machines = data.getNumMachines();
+
+    std::uniform_int_distribution<> uid(0, num_machines - 1);
+
+    for(int p = 0; p < NUM_POLICIES; ++p){
+        PolicyType policy = static_cast<PolicyType>(p);
+        auto&& policy_gen = policyGenerator(gen, policy);
+        int* chromo = arena.row(population.row(policy, ind));
+        for (int i = 0; i < total_ops; ++i) {
+            chromo[i] = uid(policy_gen);
+        }
+    }
+}
+
+// Ranks and crowding distance of every policy
+void sortPopulation(Population& population, SortMethod sort_method, std::array<FrontSet, NUM_POLICIES>& fronts,
+SeedProfile& profile, ThreadPool* pool){
+    // Every policy only writes its own ranks and distances. Its timers go to its own profile
+    std::array<SeedProfile, NUM_POLICIES> policy_profiles;
+    auto sort_policy = [&](int p, int){
+        PolicyType pol = static_cast<PolicyType>(p);
+        SeedProfile& policy_profile = pool ? policy_profiles[p] : profile;
+        FrontSet& policy_fronts = fronts[p];
+        {
+            PROFILE_SCOPE(policy_profile, Phase::SORTING);
+            nonDominatedSort(population, pol, sort_method, policy_fronts);
+        }
+        PROFILE_SCOPE(policy_profile, Phase::CROWDING);
+        for(int f = 0; f < policy_fronts.numFronts(); ++f){
+            calculateCrowdingDistance(population, policy_fronts.front(f), policy_fronts.frontSize(f), pol, policy_fronts.keys);
+        }
+    };
+
+    if(!pool){
+        for(int p = 0; p < NUM_POLICIES; ++p) sort_policy(p, 0);
+        return;
+    }
+    pool->parallelFor(NUM_POLICIES, NUM_POLICIES, sort_policy);
+    for(const SeedProfile& policy_profile : policy_profiles) mergeProfile(profile, policy_profile);
+}
+
+// Tournament selection, the survivor takes every policy from the better of two candidates
+template <typename Rng>
+void tournamentSelection(const Population& population, Population& next_population, int survivor, Rng& gen){
+    std::uniform_int_distribution<> uid(0, population.size() - 1);
+    int idx1 = uid(gen);
+    int idx2 = uid(gen);
+    while(idx1 == idx2) idx2 = uid(gen);
+
+    for(int p = 0; p < NUM_POLICIES; ++p){
+        PolicyType policy = static_cast<PolicyType>(p);
+        const int* rank = population.ranks(policy);
+        const float* cd = population.crowding(policy);
+
+        // Compare ranks, if the rank is the same, compare by CD (descending)
+        bool first_wins = rank[idx1] < rank[idx2] || (rank[idx1] == rank[idx2] && cd[idx1] > cd[idx2]);
+
+        // Parent 2 is better in the current policy... or they're exactly the same
+        next_population.copyPolicy(policy, survivor, population, first_wins ? idx1 : idx2);
+    }
+}
+
+template <typename Rng>
+void mutate(Population& offspring, int child, GeneArena& arena, Rng& gen, IndividualDelta& delta){
+    int type = std::uniform_int_distribution<>(0, 2)(gen);
+    if(type == 0) equitativeExchange(offspring, child, arena, gen, delta);
+    else if(type == 1) interChrome(offspring, child, gen, delta);
+    else circular(offspring, child, arena, gen, delta);
+}
+
+template void generateChromosome(const Data&, GeneArena&, Population&, int, std::mt19937&);
+template void generateChromosome(const Data&, GeneArena&, Population&, int, RngStream&);
+template void tournamentSelection(const Population&, Population&, int, std::mt19937&);
+template void tournamentSelection(const Population&, Population&, int, RngStream&);
+template void mutate(Population&, int, GeneArena&, std::mt19937&, IndividualDelta&);
+template void mutate(Population&, int, GeneArena&, RngStream&, IndividualDelta&);
+
+// Worst member of a policy: highest rank, then lowest crowding distance, then the last one
+static int worstMember(const Population& population, PolicyType policy, const std::vector<char>* skip = nullptr){
+    const int* rank = population.ranks(policy);
+    const float* cd = population.crowding(policy);
+    int worst = -1;
+    for(int i = 0; i < population.size(); ++i){
+        if(skip && (*skip)[i]) continue;
+        if(worst < 0 || rank[i] > rank[worst] || (rank[i] == rank[worst] && cd[i] <= cd[worst])) worst = i;
+    }
+    return worst;
+}
+
+Island::Island(const Data& data, const SchedulePlan& plan, const RunConfig& config, std::mt19937 gen, int seed, int island,
+FitnessCache* fitness_cache, SeedProfile& profile, ThreadPool* pool, int extra_rows)
+    : data(data), plan(plan), config(config), fitness_cache(fitness_cache), profile(profile),
+      pool(pool), lanes(pool ? pool->size() + 1 : 1),
+      gen(gen), stream_seed(static_cast<uint32_t>(seed)), stream_island(static_cast<uint32_t>(island)),
+      population_size(config.population_size),
+      // Parents, offspring (+1 when the last pair only keeps one child) and no more
+      arena(data.getNumTasks(), NUM_POLICIES * (2 * config.population_size + 1) + extra_rows),
+      population(config.population_size),
+      offspring_population(config.population_size + 1),
+      combined_population(2 * config.population_size),
+      next_population(config.population_size),
+      newcomer(1),
+      lane_scratch(lanes),
+      // Offspring are re-evaluated from the prefix they share with their parents
+      prefix_cache(plan, config.incremental_eval ? NUM_POLICIES * (2 * config.population_size + 1) + extra_rows : 0, lanes),
+      member_best(config.population_size + 1),
+      offspring_delta(config.population_size + 1),
+      lane_swap_mask(lanes, std::vector<char>(data.getNumTasks())),
+      migrant_genes(data.getNumTasks()){
+    for(FrontSet& fronts : front_sets) fronts.reserve(2 * population_size);
+}
+
+// Only offspring go through the fitness cache, random chromosomes are never repeated
+float Island::evaluateMember(Population& pop, int ind, const IndividualDelta* delta, int lane){
+    FitnessCache* cache = delta ? fitness_cache : nullptr;
+    if(!config.incremental_eval) return evaluateIndividual(plan, arena, pop, ind, lane_scratch[lane], cache);
+    return evaluateIndividual(plan, arena, pop, ind, prefix_cache, delta, cache, lane);
+}
+
+// Every individual writes its own fitness and rows, offspring only read their parents' states
+float Island::evaluateMembers(Population& pop, int count, bool offspring){
+    PROFILE_COUNT(profile, evaluations, count * NUM_POLICIES);
+    auto evaluate_member = [&](int ind, int lane){
+        member_best[ind] = evaluateMember(pop, ind, offspring ? &offspring_delta[ind] : nullptr, lane);
+    };
+    if(pool) pool->parallelFor(count, lanes, evaluate_member);
+    else for(int ind = 0; ind < count; ++ind) evaluate_member(ind, 0);
+
+    float best = 1e9;
+    for(int ind = 0; ind < count; ++ind) best = std::min(best, member_best[ind]);
+    return best;
+}
+
+void Island::initialize(){
+    //* Gen 0
+    {
+        PROFILE_SCOPE(profile, Phase::INITIALIZATION);
+        population.resize(population_size);
+        for(int ind = 0; ind < population_size; ++ind) arena.acquireIndividual(population, ind);
+
+        if(config.rng_mode == RngMode::STREAMS){
+            auto generate = [&](int ind, int){
+                RngStream rng = stream(RngPhase::INITIALIZATION, ind);
+                generateChromosome(data, arena, population, ind, rng);
+            };
+            if(pool) pool->parallelFor(population_size, lanes, generate);
+            else for(int ind = 0; ind < population_size; ++ind) generate(ind, 0);
+        }else{
+            for(int ind = 0; ind < population_size; ++ind) generateChromosome(data, arena, population, ind, gen);
+        }
+    }
+
+    // Evaluating Gen 0
+    {
+        PROFILE_SCOPE(profile, Phase::EVALUATION);
+        float makespan = evaluateMembers(population, population_size, false);
+        if(makespan < global_best_makespan) global_best_makespan = makespan;
+    }
+}
+
+void Island::adaptParameters(){
+    // Autoadapation logic
+    if(gens_no_improve > 5){
+        // Exploration
+        params.crossover_prob = 60;
+        params.mutation_prob = 20;
+    }else if(gens_no_improve == 0){
+        // Exploitation
+        params.crossover_prob = 90;
+        params.mutation_prob = 1;
+    }else{
+        // Balanced
+        params.crossover_prob = 80;
+        params.mutation_prob = 10;
+    }
+}
+
+void Island::trackImprovement(float current_gen_best){
+    // Check Improvement
+    if(current_gen_best < global_best_makespan){
+        global_best_makespan = current_gen_best;
+        gens_no_improve = 0;
+    } else {
+        gens_no_improve++;
+    }
+}
+
+RngStream Island::stream(RngPhase phase, int slot) const{
+    return RngStream(stream_seed, stream_island, generation, phase, slot);
+}
+
+template <typename Rng>
+void Island::breed(int child1, int child2, Rng& rng, std::vector<char>& swap_mask){
+    std::uniform_int_distribution<int> prob_gen(0, 100);
+    std::uniform_int_distribution<> random_parent(0, population_size - 1);
+
+    // Crossover
+    int idx1 = random_parent(rng);
+    int idx2 = random_parent(rng);
+
+    IndividualDelta& delta1 = offspring_delta[child1];
+    IndividualDelta& delta2 = offspring_delta[child2];
+    crossover(population, idx1, idx2, offspring_population, child1, child2, arena, rng, params.crossover_prob,
+              delta1, delta2, swap_mask);
+
+    // Mutation with adaptive probability, every child mutates with its own generator
+    if(prob_gen(rng) < params.mutation_prob){
+        auto&& child_rng = childGenerator(rng, 0);
+        mutate(offspring_population, child1, arena, child_rng, delta1);
+    }
+    if(prob_gen(rng) < params.mutation_prob){
+        auto&& child_rng = childGenerator(rng, 1);
+        mutate(offspring_population, child2, arena, child_rng, delta2);
+    }
+}
+
+// Children [0, children) of offspring_population, pair k is children 2k and 2k + 1.
+// Their rows are taken first, so the pairs only write their own rows
+void Island::breedAll(int children){
+    for(int child = 0; child < children; ++child) arena.acquireIndividual(offspring_population, child);
+
+    int pairs = children / 2;
+    if(config.rng_mode == RngMode::STREAMS){
+        auto breed_pair = [&](int pair, int lane){
+            RngStream rng = stream(RngPhase::VARIATION, pair);
+            breed(2 * pair, 2 * pair + 1, rng, lane_swap_mask[lane]);
+        };
+        if(pool) pool->parallelFor(pairs, lanes, breed_pair);
+        else for(int pair = 0; pair < pairs; ++pair) breed_pair(pair, 0);
+    }else{
+        for(int pair = 0; pair < pairs; ++pair) breed(2 * pair, 2 * pair + 1, gen, lane_swap_mask[0]);
+    }
+}
+
+void Island::generationalStep(){
+    ++generation;
+    adaptParameters();
+
+    // Offsprings. Sort the current population
+    sortPopulation(population, config.sort_method, front_sets, profile, pool);
+
+    {
+        PROFILE_SCOPE(profile, Phase::VARIATION);
+        // Pairs of children, one more when the population size is odd
+        offspring_population.resize(population_size + population_size % 2);
+        breedAll(offspring_population.size());
+        // A spare child is dropped when the population size is odd
+        offspring_population.resize(population_size);
+    }
+
+    // Evaluation offspring
+    float current_gen_best = 1e9;
+    {
+        PROFILE_SCOPE(profile, Phase::EVALUATION);
+        current_gen_best = evaluateMembers(offspring_population, population_size, true);
+    }
+    trackImprovement(current_gen_best);
+
+    // Merge & Survival, only row numbers and fitness are copied
+    {
+        PROFILE_SCOPE(profile, Phase::SELECTION);
+        combined_population.assignMerged(population, offspring_population);
+    }
+
+    // Sort mixed population
+    sortPopulation(combined_population, config.sort_method, front_sets, profile, pool);
+
+    {
+        PROFILE_SCOPE(profile, Phase::SELECTION);
+        next_population.resize(population_size);
+        if(config.rng_mode == RngMode::STREAMS){
+            auto select = [&](int survivor, int){
+                RngStream rng = stream(RngPhase::SELECTION, survivor);
+                tournamentSelection(combined_population, next_population, survivor, rng);
+            };
+            if(pool) pool->parallelFor(population_size, lanes, select);
+            else for(int survivor = 0; survivor < population_size; ++survivor) select(survivor, 0);
+        }else{
+            for(int survivor = 0; survivor < population_size; ++survivor){
+                tournamentSelection(combined_population, next_population, survivor, gen);
+            }
+        }
+        std::swap(population, next_population);
+        // Chromosomes that didn't survive give their rows back
+        arena.collect(population);
+    }
+}
+
+void Island::insertOffspring(int child){
+    {
+        PROFILE_SCOPE(profile, Phase::SELECTION);
+        newcomer.resize(1);
+        for(int p = 0; p < NUM_POLICIES; ++p) newcomer.copyPolicy(static_cast<PolicyType>(p), 0, offspring_population, child);
+        combined_population.assignMerged(population, newcomer);
+    }
+
+    sortPopulation(combined_population, config.sort_method, front_sets, profile, pool);
+
+    PROFILE_SCOPE(profile, Phase::SELECTION);
+    next_population.resize(population_size);
+    for(int p = 0; p < NUM_POLICIES; ++p){
+        PolicyType policy = static_cast<PolicyType>(p);
+        int worst = worstMember(combined_population, policy);
+        int survivor = 0;
+        for(int i = 0; i < combined_population.size(); ++i){
+            if(i != worst) next_population.copyPolicy(policy, survivor++, combined_population, i);
+        }
+    }
+    std::swap(population, next_population);
+}
+
+void Island::steadyStateStep(){
+    ++generation;
+    adaptParameters();
+    sortPopulation(population, config.sort_method, front_sets, profile, pool);
+
+    float current_gen_best = 1e9;
+    for(int inserted = 0; inserted < population_size; inserted += 2){
+        {
+            PROFILE_SCOPE(profile, Phase::VARIATION);
+            offspring_population.resize(2);
+            arena.acquireIndividual(offspring_population, 0);
+            arena.acquireIndividual(offspring_population, 1);
+            if(config.rng_mode == RngMode::STREAMS){
+                RngStream rng = stream(RngPhase::VARIATION, inserted / 2);
+                breed(0, 1, rng, lane_swap_mask[0]);
+            }else{
+                breed(0, 1, gen, lane_swap_mask[0]);
+            }
+        }
+
+        // The spare child is dropped when the population size is odd
+        int children = std::min(2, population_size - inserted);
+        {
+            PROFILE_SCOPE(profile, Phase::EVALUATION);
+            float makespan = evaluateMembers(offspring_population, children, true);
+            if(makespan < current_gen_best) current_gen_best = makespan;
+        }
+
+        for(int child = 0; child < children; ++child) insertOffspring(child);
+
+        PROFILE_SCOPE(profile, Phase::SELECTION);
+        arena.collect(population);
+    }
+    trackImprovement(current_gen_best);
+}
+
+void Island::emigrate(const std::vector<MigrationBuffer*>& destinations){
+    sortPopulation(population, config.sort_method, front_sets, profile, pool);
+
+    std::vector<int> candidates;
+    for(int p = 0; p < NUM_POLICIES; ++p){
+        PolicyType policy = static_cast<PolicyType>(p);
+        const int* rank = population.ranks(policy);
+        const float* cd = population.crowding(policy);
+
+        candidates.clear();
+        for(int i = 0; i < population.size(); ++i) if(rank[i] == 1) candidates.push_back(i);
+        std::stable_sort(candidates.begin(), candidates.end(), [cd](int a, int b){ return cd[a] > cd[b]; });
+        if(static_cast<int>(candidates.size()) > config.migration_size) candidates.resize(config.migration_size);
+
+        for(int idx : candidates){
+            Fitness fitness = {population.times(policy)[idx], population.energies(policy)[idx]};
+            const int* chromosome = arena.row(population.row(policy, idx));
+            for(MigrationBuffer* buffer : destinations) buffer->push(policy, chromosome, fitness);
+        }
+    }
+}
+
+void Island::immigrate(const std::vector<MigrationBuffer*>& sources){
+    std::array<std::vector<char>, NUM_POLICIES> replaced;
+    for(auto& flags : replaced) flags.assign(population.size(), 0);
+
+    PolicyType policy;
+    Fitness fitness;
+    for(MigrationBuffer* buffer : sources){
+        while(buffer->pop(policy, fitness, migrant_genes.data())){
+            int p = static_cast<int>(policy);
+            int worst = worstMember(population, policy, &replaced[p]);
+            if(worst < 0) continue; // Every member of the policy was already replaced
+            replaced[p][worst] = 1;
+
+            int row = arena.acquire();
+            std::copy(migrant_genes.begin(), migrant_genes.end(), arena.row(row));
+            if(config.incremental_eval) prefix_cache.invalidate(row); // The row's states belong to its old genes
+
+            population.row(policy, worst) = row;
+            population.times(policy)[worst]    = fitness.makespan;
+            population.energies(policy)[worst] = fitness.energy;
+        }
+    }
+    arena.collect(population);
+}
+
+PopulationSnapshot Island::snapshot(int generation) const{
+    PopulationSnapshot snap;
+    snap.generation = generation;
+    snap.params = params;
+    for(int p = 0; p < NUM_POLICIES; ++p){
+        PolicyType policy = static_cast<PolicyType>(p);
+        snap.times[p].assign(population.times(policy), population.times(policy) + population.size());
+        snap.energies[p].assign(population.energies(policy), population.energies(policy) + population.size());
+    }
+    return snap;
+}
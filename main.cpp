@@ -1,3 +1,5 @@
+#include "headers/binary_instance.h"
+#include "headers/config.h"
 #include "headers/read_test.h"
 #include "headers/policies.h"
 #include "headers/individual.h"
@@ -8,65 +10,54 @@
 #include <vector>
 #include <string>
 
-int main(){
+int main(int argc, char* argv[]){
     using namespace std;
 
-    // 3 test cases provided
-    vector<string> test_cases = {"Eg1", "Eg2", "Eg3"};
+    RunConfig config;
+    if(!parseArguments(argc, argv, config)) return 1;
+    if(config.show_help){
+        printUsage(argv[0]);
+        return 0;
+    }
+
+    if(config.convert_only){
+        bool all_converted = true;
+        for(const string& path : config.instances){
+            string binary_path = binaryPathFor(path);
+            if(convertToBinary(path, binary_path)) cout << path << " -> " << binary_path << "\n";
+            else all_converted = false;
+        }
+        return all_converted ? 0 : 1;
+    }
 
-    for(const string& instance_name : test_cases){
-        string current_file_path = "test/" + instance_name + ".txt";
+    for(const string& current_file_path : config.instances){
+        string instance_name = instanceName(current_file_path);
         
         cout << "\n========================================\n";
         cout << "PROCESSING INSTANCE: " << instance_name << "\n";
         cout << "File path: " << current_file_path << "\n";
         cout << "========================================\n";
 
-        ifstream file(current_file_path);
-
-        if(!file.is_open()){
-            cerr << "Test case file not found: " << current_file_path << endl;
+        // Load data, text or binary instance
+        Data data;
+        vector<vector<int>> jobs;
+        if(!openInstance(current_file_path, data, jobs, config.binary_cache)){
+            cerr << "Could not load " << instance_name << ", skipping it\n";
             continue; // Skip to the next test case
         }
-
-        // Load data
-        vector<vector<float>> time = loadTime(file);
-        vector<vector<float>> energy = loadEnergy(file);
-
-        if(time.size() != energy.size() || time[0].size() != energy[0].size()){
-            cerr << "Time and energy constraints don't match in size, check the data in " << instance_name << "\n";
-            file.close();
-            continue;
-        }
-
-        vector<vector<int>> jobs = loadWork(file);
-        
-        if(jobs.empty()){
-            cerr << "There's no workload to work with in " << instance_name << "\n";
-            file.close();
-            continue;
-        }
-        file.close();
-        
-        cout << "Data read from file succesfully\n";
-
-        Data data;
-        if(!data.loadInstance(time, energy, jobs)){
-            cerr << "Could not load data correctly for some reason...\n";
-            continue;
-        }else cout << "Instance correctly loaded\n";
+        cout << "Instance correctly loaded\n";
 
         const int tasks_tbd = data.getNumTasks();
 
         // Generate policies orderings
         auto fifo = FIFO(tasks_tbd, jobs);
-        auto ltp  = LTP (tasks_tbd, jobs, time);
-        auto stp  = STP (tasks_tbd, jobs, time);
+        auto ltp  = LTP (tasks_tbd, jobs, data);
+        auto stp  = STP (tasks_tbd, jobs, data);
         
         // Round Robin
         auto rr_fifo = RR_FIFO(tasks_tbd, jobs);
-        auto rr_ltp  = RR_LTP (tasks_tbd, jobs, time);
-        auto rr_eca  = RR_ECA (tasks_tbd, jobs, energy);
+        auto rr_ltp  = RR_LTP (tasks_tbd, jobs, data);
+        auto rr_eca  = RR_ECA (tasks_tbd, jobs, data);
         
         //* NSGAII main loop preparation
         unordered_map<PolicyType, vec_op> policies_map;
@@ -78,7 +69,7 @@ int main(){
         policies_map[PolicyType::RR_LTP]  = rr_ltp;
         policies_map[PolicyType::RR_ECA]  = rr_eca;
 
-        mainLoop(data, policies_map, instance_name);
+        mainLoop(data, policies_map, instance_name, config);
     }
     
     cout << "\nALL INSTANCES COMPLETED.\n";
@@ -0,0 +1,77 @@
+#include "headers/mapped_file.h"
+
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : bytes(nullptr), length(0), mapped(false), opened(false) {}
+
+MappedFile::~MappedFile(){
+    close();
+}
+
+bool MappedFile::open(const std::string& path){
+    close();
+
+#ifdef HAS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat info;
+    if(fstat(fd, &info) == 0 && info.st_size > 0){
+        void* view = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(view != MAP_FAILED){
+            ::close(fd); // The mapping stays valid
+            bytes  = static_cast<const char*>(view);
+            length = info.st_size;
+            mapped = true;
+            opened = true;
+            return true;
+        }
+    }
+    ::close(fd);
+#endif
+
+    // Empty files (can't be mapped) and systems without mmap
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if(!file.is_open()) return false;
+
+    buffer.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    if(!buffer.empty() && !file.read(buffer.data(), buffer.size())) return false;
+
+    bytes  = buffer.data();
+    length = buffer.size();
+    opened = true;
+    return true;
+}
+
+void MappedFile::close(){
+#ifdef HAS_MMAP
+    if(mapped) munmap(const_cast<char*>(bytes), length);
+#endif
+    buffer.clear();
+    buffer.shrink_to_fit();
+    bytes  = nullptr;
+    length = 0;
+    mapped = false;
+    opened = false;
+}
+
+bool MappedFile::isOpen() const{
+    return opened;
+}
+
+const char* MappedFile::data() const{
+    return bytes;
+}
+
+std::size_t MappedFile::size() const{
+    return length;
+}
@@ -1,4 +1,12 @@
 #include "headers/nsgaII.h"
+#include "headers/delta_eval.h"
+#include "headers/fitness_cache.h"
+#include "headers/gantt_export.h"
+#include "headers/indicators.h"
+#include "headers/island.h"
+#include "headers/output.h"
+#include "headers/profiler.h"
+#include "headers/thread_pool.h"
 
 #include <fstream>
 #include <algorithm>
@@ -6,15 +14,10 @@
 #include <numeric>
 #include <random>
 #include <filesystem>
+#include <chrono>
 #include <iostream>
-
-#define POPULATION_SIZE 10
-#define GENERATION_SIZE 100
-
-struct AdaptiveParams {
-    int crossover_prob;
-    int mutation_prob;
-};
+#include <memory>
+#include <mutex>
 
 static const std::vector<PolicyType> policy_index_map = {
     PolicyType::FIFO,
@@ -44,80 +47,25 @@ void ensureDirectoryExists(const std::string& path){
     }
 }
 
-void saveGanttToFile(const std::string& file_path, const std::vector<std::vector<Gantt>>& gantt_chart){
-    std::ofstream output_file(file_path);
-    if(!output_file.is_open()){
-        // Try to create the directory if it doesn't exist
-        size_t pos = file_path.find_last_of("/\\");
-        if(pos != std::string::npos) ensureDirectoryExists(file_path.substr(0, pos));
-        
-        output_file.open(file_path);
-        if(!output_file.is_open()){
-             std::cerr << "Error: No se pudo abrir el archivo de Gantt: " << file_path << std::endl;
-             return;
-        }
-    }
-    
-    // Header
-    output_file << "Machine_ID,Job_ID,Operation_ID,Start_Time,End_Time\n";
-    
-    for(size_t machine_id = 0; machine_id < gantt_chart.size(); ++machine_id){
-        for (const auto& task : gantt_chart[machine_id]) {
-            output_file << machine_id + 1 << ","
-            << task.job + 1 << ","
-            << task.operation + 1 << ","
-            << task.initial_time << ","
-            << task.end_time << "\n";
-        }
-    }
-    
-    output_file.close();
-    // std::cout << "Gantt saved in '" << file_path << "'." << std::endl;
-}
-
-// Generate a random chromosome for the first(s) generation(s)
-Individual generateChromosome(const Data& data, std::mt19937& gen){
-    Individual individual;
-    int total_ops    = data.getNumTasks();
-    int num_machines = data.getNumMachines();
-
-    std::uniform_int_distribution<> uid(0, num_machines - 1);
-
-    for(const auto& pol : policy_index_map){
-        PolicyType policy = pol;
-        
-        std::vector<int> chromo_vec;
-        chromo_vec.resize(total_ops);
-        for (int i = 0; i < total_ops; ++i) {
-            chromo_vec[i] = uid(gen);
-        }
-        individual.chromosome.setValue(policy, chromo_vec);
-    }
-
-    return individual;
-}
-
-std::pair<float, std::vector<std::vector<Gantt>>> totalTime(const Data& data, Individual& ind, PolicyType& policy, 
-const std::unordered_map<PolicyType, vec_op>& policies_order){
+// Makespan + Gantt diagram, only needed to export the final Pareto fronts
+std::pair<float, std::vector<std::vector<Gantt>>> totalTime(const PolicyPlan& plan, const int* chromosome){
 
-    int machines = data.getNumMachines();
-    int num_op   = data.getNumTasks();
-    int num_job  = data.getNumJobs();
+    int machines = plan.num_machines;
+    int num_op   = plan.num_ops;
+    int num_job  = plan.num_jobs;
 
     std::vector<float> job_end_time(num_job, 0.0f);
     std::vector<float> machine_end_time(machines, 0.0f);
     
     std::vector<std::vector<Gantt>> total_work(machines);
 
-    const std::vector<int> chromosome_to_eval = ind.chromosome.getValue(policy);
-    
     // Until every operation from every task is done
-    for(size_t priority = 0; priority < num_op; ++priority){
-        int machine     = chromosome_to_eval.at(priority); 
-        int current_job = policies_order.at(policy).at(priority).job_idx;
-        int current_op  = policies_order.at(policy).at(priority).op_idx;
+    for(int priority = 0; priority < num_op; ++priority){
+        int machine     = chromosome[priority]; 
+        int current_job = plan.jobs[priority];
+        int current_op  = plan.operations[priority];
         
-        float time_to_add          = data.getTime(current_op, machine);
+        float time_to_add          = plan.costRow(priority)[machine].time;
         float current_job_time     = job_end_time[current_job];
         float current_machine_time = machine_end_time[machine];
 
@@ -144,82 +92,158 @@ const std::unordered_map<PolicyType, vec_op>& policies_order){
     return {makespan, total_work};
 }
 
-float totalEnergy(const Data& data, Individual& ind, PolicyType& policy, const std::unordered_map<PolicyType, vec_op>& policies_order){
-    float tot_energy = 0.0f;
-    int operation, machine;
-    int tasks = data.getNumTasks();
+float totalMakespan(const PolicyPlan& plan, const int* chromosome, EvalScratch& scratch){
+    int num_op = plan.num_ops;
 
-    const std::vector<int> chromosome_to_eval = ind.chromosome.getValue(policy);
+    // assign() keeps the capacity, so the buffers are reused between evaluations
+    scratch.job_end_time.assign(plan.num_jobs, 0.0f);
+    scratch.machine_end_time.assign(plan.num_machines, 0.0f);
+    float* job_end_time     = scratch.job_end_time.data();
+    float* machine_end_time = scratch.machine_end_time.data();
+    const int* jobs         = plan.jobs.data();
+
+    for(int priority = 0; priority < num_op; ++priority){
+        int machine     = chromosome[priority];
+        int current_job = jobs[priority];
+
+        float best_time = std::max(job_end_time[current_job], machine_end_time[machine]);
+        best_time += plan.costRow(priority)[machine].time;
+
+        job_end_time[current_job] = best_time;
+        machine_end_time[machine] = best_time;
+    }
+
+    return *std::max_element(scratch.machine_end_time.begin(), scratch.machine_end_time.end());
+}
+
+float totalEnergy(const PolicyPlan& plan, const int* chromosome){
+    float tot_energy = 0.0f;
+    int tasks = plan.num_ops;
 
     for(int i = 0; i < tasks; ++i){
-        operation = policies_order.at(policy).at(i).op_idx;
-        machine   = chromosome_to_eval.at(i);
-        
-        tot_energy += data.getEnergy(operation, machine);
+        tot_energy += plan.costRow(i)[chromosome[i]].energy;
     }
 
     return tot_energy;
 }
 
+Fitness evaluate(const PolicyPlan& plan, const int* chromosome, EvalScratch& scratch){
+    int num_op = plan.num_ops;
+
+    scratch.job_end_time.assign(plan.num_jobs, 0.0f);
+    scratch.machine_end_time.assign(plan.num_machines, 0.0f);
+    float* job_end_time     = scratch.job_end_time.data();
+    float* machine_end_time = scratch.machine_end_time.data();
+
+    const int* jobs = plan.jobs.data();
+    float tot_energy = 0.0f;
+
+    for(int priority = 0; priority < num_op; ++priority){
+        int machine     = chromosome[priority];
+        int current_job = jobs[priority];
+
+        // Both values come from the same cache line
+        TimeEnergy cost = plan.costRow(priority)[machine];
+
+        float best_time = std::max(job_end_time[current_job], machine_end_time[machine]);
+        best_time += cost.time;
+
+        job_end_time[current_job] = best_time;
+        machine_end_time[machine] = best_time;
+
+        tot_energy += cost.energy;
+    }
+
+    float makespan = *std::max_element(scratch.machine_end_time.begin(), scratch.machine_end_time.end());
+    return {makespan, tot_energy};
+}
+
+float evaluateIndividual(const SchedulePlan& plan, const GeneArena& arena, Population& population, int ind,
+EvalScratch& scratch, FitnessCache* fitness_cache){
+    float best_makespan = 1e9;
+    forEachPolicy([&](auto policy_constant){
+        constexpr PolicyType policy = decltype(policy_constant)::value;
+        const int* chromosome = arena.row(population.row(policy, ind));
+        Fitness fitness;
+        if(!fitness_cache || !fitness_cache->lookup(policy, chromosome, fitness)){
+            fitness = evaluate(plan[policy], chromosome, scratch);
+            if(fitness_cache) fitness_cache->insert(policy, chromosome, fitness);
+        }
+
+        population.times(policy)[ind]    = fitness.makespan;
+        population.energies(policy)[ind] = fitness.energy;
+
+        best_makespan = std::min(best_makespan, fitness.makespan);
+    });
+    return best_makespan;
+}
+
 //* Genetic algorithm stuff *//
 
-// Uniform polyploid cross
-std::pair<Individual, Individual> crossover(Individual& parent1, Individual& parent2, 
-const std::unordered_map<PolicyType, vec_op>& policies_order, std::mt19937& gen, int current_crossover_prob){
+// Uniform polyploid cross. Children genes are written straight into their arena rows,
+// every child is reported as a copy of its parent from the first gene that really changed
+template <typename Rng>
+void crossover(const Population& parents, int parent1, int parent2, Population& offspring, int child1, int child2,
+GeneArena& arena, Rng& gen, int current_crossover_prob, IndividualDelta& delta1, IndividualDelta& delta2,
+std::vector<char>& swap_mask){
     // Probability param
     std::uniform_int_distribution<> uid(0, 99);
 
-    // Offsprings
-    Individual child1, child2;
-    child1.chromosome = parent1.chromosome;
-    child2.chromosome = parent2.chromosome;
-
-    int size = parent1.chromosome.getValue(PolicyType::FIFO).size();
+    int size = arena.geneLength();
     
-    std::vector<bool> swap_idx(size, false); // Indices to be swapped
-    for(size_t i = 0; i < size; ++i){
-        if(uid(gen) < current_crossover_prob){
-            swap_idx[i] = true;
-        }
+    swap_mask.resize(size); // Indices to be swapped
+    char* swap_idx = swap_mask.data();
+    for(int i = 0; i < size; ++i){
+        swap_idx[i] = uid(gen) < current_crossover_prob;
     }
 
-    for(const auto& pol_pair : policies_order){
-        PolicyType policy = pol_pair.first;
-
-        std::vector<int>& chrom1 = child1.chromosome.getValue(policy);
-        std::vector<int>& chrom2 = child2.chromosome.getValue(policy);
+    forEachPolicy([&](auto policy_constant){
+        constexpr PolicyType policy = decltype(policy_constant)::value;
+        const int* chrom_p1 = arena.row(parents.row(policy, parent1));
+        const int* chrom_p2 = arena.row(parents.row(policy, parent2));
+        int* chrom1 = arena.row(offspring.row(policy, child1));
+        int* chrom2 = arena.row(offspring.row(policy, child2));
 
-        // Swap
-        for(size_t i = 0; i < size; ++i){
+        // Copy and swap in the same pass
+        int first_changed = size;
+        for(int i = 0; i < size; ++i){
             if(swap_idx[i]){
-                std::swap(chrom1[i], chrom2[i]);
+                chrom1[i] = chrom_p2[i];
+                chrom2[i] = chrom_p1[i];
+                if(first_changed == size && chrom_p1[i] != chrom_p2[i]) first_changed = i;
+            }else{
+                chrom1[i] = chrom_p1[i];
+                chrom2[i] = chrom_p2[i];
             }
         }
-    }
-    
-    return {child1, child2};
+
+        constexpr int p = static_cast<int>(policy);
+        delta1[p] = {parents.row(policy, parent1), first_changed};
+        delta2[p] = {parents.row(policy, parent2), first_changed};
+    });
 }
 
 // Different mutations
-void interChrome(Individual& individual, std::mt19937& gen){
+// Mutations report the lowest position they changed of every chromosome in delta
+template <typename Rng>
+void interChrome(Population& population, int ind, Rng& gen, IndividualDelta& delta){
     std::uniform_int_distribution<> uid(0, policy_index_map.size() - 1); // To select two of the chromosomes
     int l = uid(gen);
     int r = uid(gen);
     // We make sure they are different
     while(l == r) r = uid(gen);
     
-    // Policies to be swapped
+    // Policies to be swapped, only their arena rows move
     PolicyType pol1 = policy_index_map[l];
     PolicyType pol2 = policy_index_map[r];
 
-    std::vector<int>& chrom1 = individual.chromosome.getValue(pol1);    
-    std::vector<int>& chrom2 = individual.chromosome.getValue(pol2);    
-
-    std::swap(chrom1, chrom2);
+    std::swap(population.row(pol1, ind), population.row(pol2, ind));
+    std::swap(delta[static_cast<int>(pol1)], delta[static_cast<int>(pol2)]);
 }
 
-void equitativeExchange(Individual& individual, std::mt19937& gen){
-    size_t pair_size = individual.chromosome.getValue(PolicyType::FIFO).size() - 1;
+template <typename Rng>
+void equitativeExchange(Population& population, int ind, GeneArena& arena, Rng& gen, IndividualDelta& delta){
+    size_t pair_size = arena.geneLength() - 1;
     if(pair_size < 1) return; 
 
     std::uniform_int_distribution<> uid_pair(0, pair_size / 2);
@@ -227,74 +251,85 @@ void equitativeExchange(Individual& individual, std::mt19937& gen){
 
     // Each policy might mutate differently
     for(const auto& policy : policy_index_map){
+        auto&& policy_gen = policyGenerator(gen, policy);
         // Selection of the number of pairs and it's idx
-        int total_pairs = uid_pair(gen);
-        std::vector<std::pair<int, int>> chrom_pair;
+        int total_pairs = uid_pair(policy_gen);
+        int* chrom = arena.row(population.row(policy, ind));
         
         // Safety check to avoid infinite loop if size is too small
-        int attempts = 0;
-        while(chrom_pair.size() != total_pairs && attempts < 100){
-            int l = uid(gen);
-            int r = uid(gen);
-            while(l == r) r = uid(gen);
-            chrom_pair.push_back({l, r});
-            attempts++;
-        }
-        
-        std::vector<int>& chrom = individual.chromosome.getValue(policy);
-
-        for(const auto& pr : chrom_pair){
-            std::swap(chrom[pr.first], chrom[pr.second]);
+        for(int attempts = 0; attempts < total_pairs && attempts < 100; ++attempts){
+            int l = uid(policy_gen);
+            int r = uid(policy_gen);
+            while(l == r) r = uid(policy_gen);
+            if(chrom[l] != chrom[r]) markChanged(delta[static_cast<int>(policy)], std::min(l, r));
+            std::swap(chrom[l], chrom[r]);
         }
-
     }
 }
 
-void circular(Individual& individual, std::mt19937& gen){
-    size_t chromo_size = individual.chromosome.getValue(PolicyType::FIFO).size();
+template <typename Rng>
+void circular(Population& population, int ind, GeneArena& arena, Rng& gen, IndividualDelta& delta){
+    size_t chromo_size = arena.geneLength();
     if(chromo_size < 2) return;
 
     std::uniform_int_distribution<> uid(0, chromo_size - 1);
 
     for(const auto& policy : policy_index_map){
-        std::vector<int>& chromo = individual.chromosome.getValue(policy);
+        auto&& policy_gen = policyGenerator(gen, policy);
+        int* chromo = arena.row(population.row(policy, ind));
 
         // 1. Select Segment
-        int l = uid(gen);
-        int r = uid(gen);
+        int l = uid(policy_gen);
+        int r = uid(policy_gen);
         int start = std::min(l, r);
         int end   = std::max(l, r);
-        
-        // Copy segment
-        std::vector<int> segment;
-        for(int i=start; i<=end; ++i) segment.push_back(chromo[i]);
-
-        // 2. Erase segment from original (Cut)
-        chromo.erase(chromo.begin() + start, chromo.begin() + end + 1);
+        int segment_size = end - start + 1;
 
-        // 3. Insert in new position (Paste)
-        // New size is smaller, so we gen a new index
-        std::uniform_int_distribution<> uid_ins(0, chromo.size()); 
-        int ins_point = uid_ins(gen);
+        // 2. New position once the segment is cut, it's an index of the shorter chromosome
+        std::uniform_int_distribution<> uid_ins(0, chromo_size - segment_size); 
+        int ins_point = uid_ins(policy_gen);
         
-        chromo.insert(chromo.begin() + ins_point, segment.begin(), segment.end());
+        // 3. Cut and paste is a rotation of the genes between both positions
+        if(ins_point != start) markChanged(delta[static_cast<int>(policy)], std::min(ins_point, start));
+        if(ins_point <= start){
+            std::rotate(chromo + ins_point, chromo + start, chromo + end + 1);
+        }else{
+            std::rotate(chromo + start, chromo + end + 1, chromo + ins_point + segment_size);
+        }
     }
 }
 
+template void crossover(const Population&, int, int, Population&, int, int, GeneArena&, std::mt19937&, int,
+                        IndividualDelta&, IndividualDelta&, std::vector<char>&);
+template void crossover(const Population&, int, int, Population&, int, int, GeneArena&, RngStream&, int,
+                        IndividualDelta&, IndividualDelta&, std::vector<char>&);
+template void interChrome(Population&, int, std::mt19937&, IndividualDelta&);
+template void interChrome(Population&, int, RngStream&, IndividualDelta&);
+template void equitativeExchange(Population&, int, GeneArena&, std::mt19937&, IndividualDelta&);
+template void equitativeExchange(Population&, int, GeneArena&, RngStream&, IndividualDelta&);
+template void circular(Population&, int, GeneArena&, std::mt19937&, IndividualDelta&);
+template void circular(Population&, int, GeneArena&, RngStream&, IndividualDelta&);
+
 //* Main NSGAII Algorithm *//
-std::vector<std::vector<int>> fastNonDominatedSort(std::vector<Individual>& population, const PolicyType& policy){
+void fastNonDominatedSort(Population& population, const PolicyType& policy, FrontSet& fronts){
+    const int size = population.size();
+    const float* time   = population.times(policy);
+    const float* energy = population.energies(policy);
+    int* ranks          = population.ranks(policy);
+
     // Domination
-    std::vector<std::vector<int>> dominated_solutions(population.size());
-    std::vector<int> domination_count(population.size(), 0);
+    std::vector<int>& domination_count = fronts.domination_count;
+    domination_count.assign(size, 0);
+    fronts.dominations.clear();
 
     // First: Calculate which solutions dominate others for ONE policy
-    for(size_t i = 0; i < population.size(); ++i){
-        for (size_t j = i + 1; j < population.size(); ++j){
+    for(int i = 0; i < size; ++i){
+        for (int j = i + 1; j < size; ++j){
             // Values from current policy
-            float time_i   = population[i].time_fitness.getValue(policy);
-            float energy_i = population[i].energy_fitness.getValue(policy);
-            float time_j   = population[j].time_fitness.getValue(policy);
-            float energy_j = population[j].energy_fitness.getValue(policy);
+            float time_i   = time[i];
+            float energy_i = energy[i];
+            float time_j   = time[j];
+            float energy_j = energy[j];
 
             bool i_dominates_j = (time_i <= time_j && energy_i <= energy_j) &&
                                  (time_i < time_j || energy_i < energy_j);
@@ -302,370 +337,577 @@ std::vector<std::vector<int>> fastNonDominatedSort(std::vector<Individual>& popu
                                  (time_j < time_i || energy_j < energy_i);
 
             if(i_dominates_j){
-                dominated_solutions[i].push_back(j);
+                fronts.dominations.push_back({i, j});
                 domination_count[j]++;
             }else if(j_dominates_i){
-                dominated_solutions[j].push_back(i);
+                fronts.dominations.push_back({j, i});
                 domination_count[i]++;
             }
         }
     }
+
+    // Dominated solutions of every individual, contiguous and in ascending order
+    std::vector<int>& dominated_start = fronts.dominated_start;
+    dominated_start.assign(size + 1, 0);
+    for(const auto& domination : fronts.dominations) ++dominated_start[domination.first + 1];
+    for(int i = 0; i < size; ++i) dominated_start[i + 1] += dominated_start[i];
+    fronts.dominated.reserve(fronts.dominations.capacity()); // Grows like the pairs, not one size at a time
+    fronts.dominated.resize(fronts.dominations.size());
+    for(const auto& domination : fronts.dominations) fronts.dominated[dominated_start[domination.first]++] = domination.second;
+    for(int i = size; i > 0; --i) dominated_start[i] = dominated_start[i - 1];
+    dominated_start[0] = 0;
+
     // Then, identify the first front
-    std::vector<std::vector<int>> fronts_indices;
-    std::vector<int> current_front_indices;
-    for(size_t i = 0; i < population.size(); ++i){
+    std::vector<int>& order = fronts.order;
+    order.clear();
+    fronts.starts.assign(1, 0);
+    for(int i = 0; i < size; ++i){
         if(domination_count[i] == 0){
-            population[i].rank.setValue(policy, 1);
-            current_front_indices.push_back(i);
+            ranks[i] = 1;
+            order.push_back(i);
         }
     }
-    fronts_indices.push_back(current_front_indices);
+    fronts.starts.push_back(order.size());
 
     // After that, build the next fronts
     int rank = 1;
-    while(!fronts_indices[rank - 1].empty()){
-        std::vector<int> next_front_indices;
+    while(fronts.starts[rank - 1] != fronts.starts[rank]){
+        int front_end = fronts.starts[rank];
         // For each individual 'p' in the actual front
-        for(int p_idx : fronts_indices[rank - 1]){
+        for(int k = fronts.starts[rank - 1]; k < front_end; ++k){
+            int p_idx = order[k];
             // looks all the solutions 'q' that it dominates
-            for(int q_idx : dominated_solutions[p_idx]){
+            for(int d = dominated_start[p_idx]; d < dominated_start[p_idx + 1]; ++d){
+                int q_idx = fronts.dominated[d];
                 // and decrease it's counter of domination
                 domination_count[q_idx]--;
                 // If the counter reaches 0, 'q' belongs in the next front
                 if(domination_count[q_idx] == 0){
-                    population[q_idx].rank.setValue(policy, rank + 1);
-                    next_front_indices.push_back(q_idx);
+                    ranks[q_idx] = rank + 1;
+                    order.push_back(q_idx);
                 }
             }
         }
-        
-        if(next_front_indices.empty()) break;
-        
-        fronts_indices.push_back(next_front_indices);
+
+        if(static_cast<int>(order.size()) == front_end) break;
+
+        fronts.starts.push_back(order.size());
         rank++;
     }
-    
+}
+
+// Sort-and-sweep for two objectives (Jensen / Kung), O(N log N).
+// Same ranks as fastNonDominatedSort, but the indices of every front are in ascending order
+void sweepNonDominatedSort(Population& population, const PolicyType& policy, FrontSet& fronts){
+    const int size = population.size();
+    const float* time   = population.times(policy);
+    const float* energy = population.energies(policy);
+    int* ranks          = population.ranks(policy);
+
+    std::vector<int>& by_time = fronts.by_time;
+    by_time.resize(size);
+    std::iota(by_time.begin(), by_time.end(), 0);
+    std::sort(by_time.begin(), by_time.end(), [time, energy](int a, int b){
+        if(time[a] != time[b]) return time[a] < time[b];
+        return energy[a] < energy[b];
+    });
+
+    // Last individual added to every front. Inside a front the time grows and the energy
+    // drops, so the last one is the only one that has to be checked for domination
+    std::vector<int>& front_tail = fronts.front_tail;
+    front_tail.clear();
+    for(int idx : by_time){
+        auto dominated_by = [&](int front){
+            int tail = front_tail[front];
+            return energy[tail] < energy[idx] || (energy[tail] == energy[idx] && time[tail] < time[idx]);
+        };
+
+        // Fronts dominating idx come first, binary search for the first one that doesn't
+        int low = 0, high = front_tail.size();
+        while(low < high){
+            int mid = (low + high) / 2;
+            if(dominated_by(mid)) low = mid + 1;
+            else high = mid;
+        }
+
+        if(low == static_cast<int>(front_tail.size())) front_tail.push_back(idx);
+        else front_tail[low] = idx;
+        ranks[idx] = low + 1;
+    }
+
+    // Counting sort by rank, ascending indices inside every front
+    std::vector<int>& starts = fronts.starts;
+    starts.assign(std::max<size_t>(front_tail.size(), 1) + 1, 0);
+    for(int i = 0; i < size; ++i) ++starts[ranks[i]];
+    for(size_t f = 1; f < starts.size(); ++f) starts[f] += starts[f - 1];
+    fronts.order.resize(size);
+    for(int i = 0; i < size; ++i) fronts.order[starts[ranks[i] - 1]++] = i;
+    for(size_t f = starts.size() - 1; f > 0; --f) starts[f] = starts[f - 1];
+    starts[0] = 0;
+}
+
+void nonDominatedSort(Population& population, const PolicyType& policy, SortMethod method, FrontSet& fronts){
+    if(method == SortMethod::SWEEP) sweepNonDominatedSort(population, policy, fronts);
+    else fastNonDominatedSort(population, policy, fronts);
+}
+
+static std::vector<std::vector<int>> frontVectors(FrontSet& fronts){
+    std::vector<std::vector<int>> fronts_indices;
+    for(int f = 0; f < fronts.numFronts(); ++f){
+        fronts_indices.emplace_back(fronts.front(f), fronts.front(f) + fronts.frontSize(f));
+    }
     return fronts_indices;
 }
 
-void calculateCrowdingDistance(std::vector<Individual>& front, const PolicyType& policy){
-    if (front.empty()) return;
-    int size = front.size();
-    for(auto& ind : front){
-        ind.crowding_distance.setValue(policy, 0);
+std::vector<std::vector<int>> fastNonDominatedSort(Population& population, const PolicyType& policy){
+    FrontSet fronts;
+    fastNonDominatedSort(population, policy, fronts);
+    return frontVectors(fronts);
+}
+
+std::vector<std::vector<int>> sweepNonDominatedSort(Population& population, const PolicyType& policy){
+    FrontSet fronts;
+    sweepNonDominatedSort(population, policy, fronts);
+    return frontVectors(fronts);
+}
+
+std::vector<std::vector<int>> nonDominatedSort(Population& population, const PolicyType& policy, SortMethod method){
+    FrontSet fronts;
+    nonDominatedSort(population, policy, method, fronts);
+    return frontVectors(fronts);
+}
+
+// The keys are sorted by objective only, so the indices end in the same order as sorting
+// them with an objective comparator
+void calculateCrowdingDistance(Population& population, int* front, int size, const PolicyType& policy,
+std::vector<std::pair<float, int>>& keys){
+    if (size == 0) return;
+    const float* time   = population.times(policy);
+    const float* energy = population.energies(policy);
+    float* cd           = population.crowding(policy);
+
+    for(int i = 0; i < size; ++i){
+        cd[front[i]] = 0;
     }
+    if(static_cast<int>(keys.size()) < size) keys.resize(size);
+    auto by_objective = [](const std::pair<float, int>& a, const std::pair<float, int>& b){
+        return a.first < b.first;
+    };
 
     // Obj 1: Time
-    std::sort(front.begin(), front.end(), [policy](const Individual& a, const Individual& b){
-        return a.time_fitness.getValue(policy) < b.time_fitness.getValue(policy);
-    });
-    front[0].crowding_distance.setValue(policy, 1e9); // Infinity
-    front.back().crowding_distance.setValue(policy, 1e9);
+    for(int i = 0; i < size; ++i) keys[i] = {time[front[i]], front[i]};
+    std::sort(keys.begin(), keys.begin() + size, by_objective);
+    for(int i = 0; i < size; ++i) front[i] = keys[i].second;
+    cd[front[0]] = 1e9; // Infinity
+    cd[front[size - 1]] = 1e9;
     
-    float min_time = front[0].time_fitness.getValue(policy);
-    float max_time = front.back().time_fitness.getValue(policy);
+    float min_time = keys[0].first;
+    float max_time = keys[size - 1].first;
     float range_time = max_time - min_time;
     
     if(range_time > 0){
         for(int i = 1; i < size - 1; ++i){
-            float current_cd = front[i].crowding_distance.getValue(policy);
-            current_cd += (front[i + 1].time_fitness.getValue(policy) - front[i - 1].time_fitness.getValue(policy)) / range_time;
-            front[i].crowding_distance.setValue(policy, current_cd);
+            cd[front[i]] += (keys[i + 1].first - keys[i - 1].first) / range_time;
         }
     }
 
     // Obj 2: Energy
-    std::sort(front.begin(), front.end(), [policy](const Individual& a, const Individual& b){
-        return a.energy_fitness.getValue(policy) < b.energy_fitness.getValue(policy);
-    });
-    front[0].crowding_distance.setValue(policy, 1e9);
-    front.back().crowding_distance.setValue(policy, 1e9);
+    for(int i = 0; i < size; ++i) keys[i] = {energy[front[i]], front[i]};
+    std::sort(keys.begin(), keys.begin() + size, by_objective);
+    for(int i = 0; i < size; ++i) front[i] = keys[i].second;
+    cd[front[0]] = 1e9;
+    cd[front[size - 1]] = 1e9;
     
-    float min_energy = front[0].energy_fitness.getValue(policy);
-    float max_energy = front.back().energy_fitness.getValue(policy);
+    float min_energy = keys[0].first;
+    float max_energy = keys[size - 1].first;
     float range_energy = max_energy - min_energy;
 
     if(range_energy > 0){
         for(int i = 1; i < size - 1; ++i){
-            float current_cd = front[i].crowding_distance.getValue(policy);
-            current_cd += (front[i + 1].energy_fitness.getValue(policy) - front[i - 1].energy_fitness.getValue(policy)) / range_energy;
-            front[i].crowding_distance.setValue(policy, current_cd);
+            cd[front[i]] += (keys[i + 1].first - keys[i - 1].first) / range_energy;
         }
     }
 }
 
-// Tournament selection
-Individual tournamentSelection(std::vector<Individual>& population, std::mt19937& gen){
-    std::uniform_int_distribution<> uid(0, population.size() - 1);
-    int idx1 = uid(gen);
-    int idx2 = uid(gen);
-    while(idx1 == idx2) idx2 = uid(gen);
-
-    Individual& parent1 = population[idx1];
-    Individual& parent2 = population[idx2];
-
-    Individual super_individual;
-
-    for(const PolicyType& policy : policy_index_map){
-        // Exclusive comparator for the Individuals
-        IndividualComparator comparator(policy);
-
-        if(comparator(parent1, parent2)){
-            // Parent 1 is better in the current policy
-            super_individual.chromosome.setValue(policy, parent1.chromosome.getValue(policy));
-            super_individual.time_fitness.setValue(policy, parent1.time_fitness.getValue(policy));
-            super_individual.energy_fitness.setValue(policy, parent1.energy_fitness.getValue(policy));
-            super_individual.rank.setValue(policy, parent1.rank.getValue(policy));
-            super_individual.crowding_distance.setValue(policy, parent1.crowding_distance.getValue(policy));
-        }else{
-            // Parent 2 is better in the current policy... or they're exactly the same
-            super_individual.chromosome.setValue(policy, parent2.chromosome.getValue(policy));
-            super_individual.time_fitness.setValue(policy, parent2.time_fitness.getValue(policy));
-            super_individual.energy_fitness.setValue(policy, parent2.energy_fitness.getValue(policy));
-            super_individual.rank.setValue(policy, parent2.rank.getValue(policy));
-            super_individual.crowding_distance.setValue(policy, parent2.crowding_distance.getValue(policy));
+void calculateCrowdingDistance(Population& population, std::vector<int>& front, const PolicyType& policy){
+    std::vector<std::pair<float, int>> keys;
+    calculateCrowdingDistance(population, front.data(), front.size(), policy, keys);
+}
+
+// Hypervolume reference point from the instance bounds: every operation on its slowest
+// (and most expensive) machine, one after the other. No schedule can be worse than that
+static ObjectivePoint hypervolumeReference(const Data& data, const vec_op& operations){
+    ObjectivePoint worst = {0.0, 0.0};
+    for(const OperationsID& operation : operations){
+        const float* time   = data.timeRow(operation.op_idx);
+        const float* energy = data.energyRow(operation.op_idx);
+        worst.time   += *std::max_element(time, time + data.getNumMachines());
+        worst.energy += *std::max_element(energy, energy + data.getNumMachines());
+    }
+    return worst;
+}
+
+// Everything a seed writes to the shared files of the instance
+struct SeedOutput{
+    std::string checkpoint_rows;
+    GanttBatch gantt; // Written by the export stage
+    SeedProfile profile;
+};
+
+// Pareto fronts of a checkpoint and their quality indicators. The snapshots of every
+// island are logged together, as one population
+static void logCheckpoint(const std::vector<const PopulationSnapshot*>& snapshots, int seed, SortMethod sort_method,
+const ObjectivePoint& reference_point, CsvBuffer& seed_log, CsvBuffer& seed_indicators){
+    int total = 0;
+    for(const PopulationSnapshot* snapshot : snapshots) total += snapshot->times[0].size();
+
+    // Adaptive params of the island every member comes from
+    Population population(total);
+    population.resize(total);
+    std::vector<const AdaptiveParams*> member_params(total);
+    int generation = snapshots.front()->generation;
+
+    int offset = 0;
+    for(const PopulationSnapshot* snapshot : snapshots){
+        int size = snapshot->times[0].size();
+        for(int p = 0; p < NUM_POLICIES; ++p){
+            PolicyType policy = static_cast<PolicyType>(p);
+            std::copy(snapshot->times[p].begin(), snapshot->times[p].end(), population.times(policy) + offset);
+            std::copy(snapshot->energies[p].begin(), snapshot->energies[p].end(), population.energies(policy) + offset);
         }
+        for(int i = 0; i < size; ++i) member_params[offset + i] = &snapshot->params;
+        offset += size;
     }
 
-    return super_individual;
+    std::array<std::vector<ObjectivePoint>, NUM_POLICIES> policy_fronts;
+
+    for(const auto& policy : policy_index_map){
+        auto fronts_indices = nonDominatedSort(population, policy, sort_method);
+        if(fronts_indices.empty()) continue;
+
+        // The first front is saved
+        const std::vector<int>& pareto_indices = fronts_indices[0];
+        if(pareto_indices.empty()) continue;
+
+        const float* time   = population.times(policy);
+        const float* energy = population.energies(policy);
+        for(int idx : pareto_indices){
+            seed_log.add(seed)
+                    .add(generation)
+                    .add(policyToString(policy))
+                    .add(1) // Rank 1
+                    .add(time[idx])
+                    .add(energy[idx])
+                    .add(member_params[idx]->crossover_prob)
+                    .add(member_params[idx]->mutation_prob);
+            seed_log.endRow();
+
+            policy_fronts[static_cast<int>(policy)].push_back({time[idx], energy[idx]});
+        }
+    }
+
+    // Quality of every policy against the best front found by all of them
+    std::vector<ObjectivePoint> all_points;
+    for(const auto& front : policy_fronts) all_points.insert(all_points.end(), front.begin(), front.end());
+    const std::vector<ObjectivePoint> global_front = nonDominatedPoints(all_points);
+
+    for(const auto& policy : policy_index_map){
+        const std::vector<ObjectivePoint>& front = policy_fronts[static_cast<int>(policy)];
+        if(front.empty()) continue;
+
+        seed_indicators.add(seed)
+                       .add(generation)
+                       .add(policyToString(policy))
+                       .add(static_cast<int>(front.size()))
+                       .add(hypervolume(front, reference_point))
+                       .add(invertedGenerationalDistance(front, global_front))
+                       .add(spread(front, global_front))
+                       .add(additiveEpsilon(front, global_front))
+                       .add(reference_point.time)
+                       .add(reference_point.energy);
+        seed_indicators.endRow();
+    }
 }
 
-void mainLoop(const Data& data, const std::unordered_map<PolicyType, vec_op>& policies_order, const std::string& instance_name){
-    // 30 Semillas requeridas
-    const int seeds[] = {0, 1, 2, 3, 5, 7, 11, 13, 17, 19, 
-                         23, 29, 31, 37, 41, 43, 47, 53, 59, 61,
-                         67, 71, 73, 79, 83, 89, 97, 101, 103, 107};
+// Chromosomes of the final Pareto front of every policy, in the order their schedules are exported
+static void collectGanttFronts(Population& population, const GeneArena& arena, int seed, const RunConfig& config,
+GanttBatch& batch){
+    batch.seed = seed;
+    batch.gene_length = arena.geneLength();
+    for(auto policy : policy_index_map){
+        auto final_front = nonDominatedSort(population, policy, config.sort_method);
+
+        if(final_front.empty()) continue;
+
+        std::vector<int>& pareto_indices = final_front[0];
+        calculateCrowdingDistance(population, pareto_indices, policy);
+
+        // Sort by time to be consistent
+        const float* time = population.times(policy);
+        std::sort(pareto_indices.begin(), pareto_indices.end(), [time](int a, int b){
+            return time[a] < time[b];
+        });
+
+        std::vector<int>& genes = batch.genes[static_cast<int>(policy)];
+        genes.reserve(pareto_indices.size() * batch.gene_length);
+        for(int idx : pareto_indices){
+            const int* chromosome = arena.row(population.row(policy, idx));
+            genes.insert(genes.end(), chromosome, chromosome + batch.gene_length);
+        }
+    }
+}
 
-    std::random_device rd;
-    std::mt19937 gen;
-    std::uniform_int_distribution<int> prob_gen(0, 100);
-    
-    // Main GA loop params
-    const int population_size = POPULATION_SIZE;
-    const int generation_size = GENERATION_SIZE;
-    
-    std::uniform_int_distribution<> random_parent(0, population_size - 1);
-    
+// One complete evolution for a single seed. Every call owns its RNG and buffers,
+// so seeds can run concurrently; the output is returned to keep the shared files ordered.
+static SeedOutput runSeed(const Data& data, const SchedulePlan& plan, int seed, const RunConfig& config, const ObjectivePoint& reference_point,
+FitnessCache* fitness_cache, ThreadPool& seed_pool, SeedOrderedWriter& indicators, size_t seed_index){
+    // The islands always share the workers, the steps inside their generations only when asked
+    ThreadPool* pool = config.parallel_generation ? &seed_pool : nullptr;
+    auto seed_start = std::chrono::steady_clock::now();
+    SeedOutput output;
+    SeedProfile& profile = output.profile;
+    profile.seed = seed;
+
+    const int generation_size = config.generation_size;
+
+    CsvBuffer seed_log;
+    CsvBuffer seed_indicators;
+
+    // The generational and steady state engines are a single island
+    const int num_islands = config.engine == Engine::ISLAND ? config.num_islands : 1;
+    const bool migrate = num_islands > 1 && config.migration_size > 0;
+
+    // One buffer per edge of the topology, incoming buffers are ordered by source island
+    std::vector<std::unique_ptr<MigrationBuffer>> buffers;
+    std::vector<std::vector<MigrationBuffer*>> outgoing(num_islands), incoming(num_islands);
+    if(migrate){
+        for(int from = 0; from < num_islands; ++from){
+            for(int to = 0; to < num_islands; ++to){
+                bool linked = config.topology == Topology::ALL ? to != from : to == (from + 1) % num_islands;
+                if(!linked) continue;
+                buffers.push_back(std::make_unique<MigrationBuffer>(data.getNumTasks(), NUM_POLICIES * config.migration_size));
+                outgoing[from].push_back(buffers.back().get());
+                incoming[to].push_back(buffers.back().get());
+            }
+        }
+    }
+
+    std::vector<SeedProfile> island_profiles(num_islands);
+    std::vector<std::unique_ptr<Island>> islands;
+    for(int i = 0; i < num_islands; ++i){
+        // The single island keeps the RNG stream of the seed
+        std::mt19937 gen(seed);
+        if(num_islands > 1){
+            std::seed_seq island_seed = {seed, i};
+            gen.seed(island_seed);
+        }
+        SeedProfile& island_profile = num_islands > 1 ? island_profiles[i] : profile;
+        int extra_rows = incoming[i].size() * NUM_POLICIES * config.migration_size;
+        islands.push_back(std::make_unique<Island>(data, plan, config, gen, seed, i, fitness_cache, island_profile, pool,
+                                                  extra_rows));
+    }
+
+    // A checkpoint is logged once every island has reached it
+    std::vector<std::vector<PopulationSnapshot>> snapshots(num_islands);
+    size_t logged = 0;
+
+    // Islands are tasks of the pool: the seed's thread runs some of them and the other
+    // workers can pick up the rest, or the inner loops of the islands, instead of
+    // blocking on extra threads
+    auto forEachIsland = [&](auto&& body){
+        seed_pool.parallelFor(num_islands, num_islands, [&](int i, int){ body(i); });
+    };
+
+    // Save stats every checkpoint_interval gens AND INCLUDE ADAPTIVE PARAMS
+    auto checkpoint = [&](int i, int generation){
+        if((generation + 1) % config.checkpoint_interval == 0 || generation == 0){
+            SeedProfile& island_profile = num_islands > 1 ? island_profiles[i] : profile;
+            PROFILE_SCOPE(island_profile, Phase::CHECKPOINT);
+            snapshots[i].push_back(islands[i]->snapshot(generation + 1));
+        }
+    };
+
+    forEachIsland([&](int i){ islands[i]->initialize(); });
+
+    // Indicators of the new checkpoints go to the file at once, so the convergence
+    // can be followed while the run goes on
+    auto logCheckpoints = [&](){
+        PROFILE_SCOPE(profile, Phase::CHECKPOINT);
+        std::vector<const PopulationSnapshot*> checkpoint(num_islands);
+        for(; logged < snapshots[0].size(); ++logged){
+            for(int i = 0; i < num_islands; ++i) checkpoint[i] = &snapshots[i][logged];
+            logCheckpoint(checkpoint, seed, config.sort_method, reference_point, seed_log, seed_indicators);
+        }
+        if(seed_indicators.size() > 0) indicators.write(seed_index, seed_indicators.str());
+        seed_indicators.clear();
+    };
+
+    // Generations run in segments that end where the islands migrate or reach a checkpoint
+    for(int start = 0; start < generation_size; ){
+        int end = std::min(generation_size, start == 0 ? 1 : (start / config.checkpoint_interval + 1) * config.checkpoint_interval);
+        if(migrate) end = std::min(end, (start / config.migration_interval + 1) * config.migration_interval);
+        const bool migrating = migrate && end % config.migration_interval == 0 && end < generation_size;
+
+        forEachIsland([&](int i){
+            Island& island = *islands[i];
+            for(int generation = start; generation < end; ++generation){
+                if(config.engine == Engine::STEADY_STATE) island.steadyStateStep();
+                else island.generationalStep();
+
+                // The last generation before a migration is saved once the migrants arrived
+                if(generation + 1 < end || !migrating) checkpoint(i, generation);
+            }
+        });
+
+        // Synchronous migration on the seed's thread: every island sends, then every island
+        // receives, at the same generation, so runs are reproducible
+        if(migrating){
+            for(int i = 0; i < num_islands; ++i) islands[i]->emigrate(outgoing[i]);
+            for(int i = 0; i < num_islands; ++i){
+                islands[i]->immigrate(incoming[i]);
+                checkpoint(i, end - 1);
+            }
+        }
+        logCheckpoints();
+        start = end;
+    } // End Gen Loop
+
+    if(num_islands > 1){
+        for(const SeedProfile& island_profile : island_profiles) mergeProfile(profile, island_profile);
+    }
+
+    // Fronts of the Gantt export, their schedules are rebuilt and written by the export stage
+    if(config.gantt_output != GanttOutput::NONE){
+        PROFILE_SCOPE(profile, Phase::GANTT);
+        if(num_islands == 1){
+            collectGanttFronts(islands[0]->currentPopulation(), islands[0]->genes(), seed, config, output.gantt);
+        }else{
+            // The final front is taken from the individuals of every island
+            const int size = config.population_size;
+            GeneArena arena(data.getNumTasks(), NUM_POLICIES * size * num_islands);
+            Population population(size * num_islands);
+            population.resize(size * num_islands);
+            for(int i = 0; i < num_islands; ++i){
+                Population& island_population = islands[i]->currentPopulation();
+                for(int p = 0; p < NUM_POLICIES; ++p){
+                    PolicyType policy = static_cast<PolicyType>(p);
+                    for(int ind = 0; ind < size; ++ind){
+                        int merged = i * size + ind;
+                        population.copyPolicy(policy, merged, island_population, ind);
+                        int row = arena.acquire();
+                        const int* genes = islands[i]->genes().row(island_population.row(policy, ind));
+                        std::copy(genes, genes + data.getNumTasks(), arena.row(row));
+                        population.row(policy, merged) = row;
+                    }
+                }
+            }
+            collectGanttFronts(population, arena, seed, config, output.gantt);
+        }
+    }
+
+    output.checkpoint_rows = seed_log.str();
+    indicators.finish(seed_index);
+
+    profile.total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - seed_start).count();
+    return output;
+}
+
+void mainLoop(const Data& data, const std::unordered_map<PolicyType, vec_op>& policies_order, const std::string& instance_name,
+const RunConfig& config){
     // Output base path
-    std::string base_path = "results/" + instance_name;
+    std::string base_path = config.output_dir + "/" + instance_name;
     ensureDirectoryExists(base_path);
-    for(const auto& pol : policy_index_map) ensureDirectoryExists(base_path + "/" + policyToString(pol));
+    if(config.gantt_output == GanttOutput::FILES){
+        for(const auto& pol : policy_index_map) ensureDirectoryExists(base_path + "/" + policyToString(pol));
+    }
 
     // Unique report file per instance
     std::string log_filepath = base_path + "/all_checkpoint_fronts.csv";
-    std::ofstream log_file(log_filepath);
+    BufferedFile log_file;
 
-    if(!log_file.is_open()){
+    if(!log_file.open(log_filepath)){
         std::cerr << "Error: Could'nt open the stats file: " << log_filepath << std::endl;
         return;
     }
     // Header
-    log_file << "Seed,Generation,Policy,Rank,Time_Fitness,Energy_Fitness,Crossover_P,Mutation_P\n";
-    
-    // Seed loop
-    for(int seed : seeds){
-        std::cout << "[" << instance_name << "] Seed: " << seed << "...\n";
-        gen.seed(seed);
-        
-        std::vector<Individual> population(population_size);
-        //* Gen 0
-        for(Individual& pop : population) pop = generateChromosome(data, gen);
+    log_file.write("Seed,Generation,Policy,Rank,Time_Fitness,Energy_Fitness,Crossover_P,Mutation_P\n");
 
-        // Initial adaptive parameters
-        AdaptiveParams params = {80, 10}; 
-        
-        // To monitor improvement
-        float global_best_makespan = 1e9;
-        int gens_no_improve = 0;
+    // Quality indicators of every checkpoint front
+    std::string indicators_filepath = base_path + "/quality_indicators.csv";
+    BufferedFile indicators_file;
+    if(!indicators_file.open(indicators_filepath)){
+        std::cerr << "Error: Could'nt open the indicators file: " << indicators_filepath << std::endl;
+        return;
+    }
+    indicators_file.write("Seed,Generation,Policy,Front_Size,Hypervolume,IGD,Spread,Epsilon,HV_Ref_Time,HV_Ref_Energy\n");
+    const ObjectivePoint reference_point = hypervolumeReference(data, policies_order.at(PolicyType::FIFO));
 
-        // Evaluating Gen 0
-        for(const auto& pol : policies_order){
-            PolicyType policy = pol.first;
-            for(Individual& ind : population){
-                auto [makespan, _] = totalTime(data, ind, policy, policies_order);
-                float energy   = totalEnergy(data, ind, policy, policies_order);
+    // The orderings compiled once, every evaluation of the instance reads from it
+    const SchedulePlan plan(data, policies_order, static_cast<size_t>(config.plan_cost_mb) << 20);
 
-                ind.time_fitness.setValue(policy, makespan);
-                ind.energy_fitness.setValue(policy, energy);
+    // Schedules of the final fronts, written while the next seeds evolve
+    GanttExporter gantt_exporter(plan, config, base_path, config.gantt_queue);
+    if(!gantt_exporter.start()) return;
 
-                if(makespan < global_best_makespan) global_best_makespan = makespan;
-            }
-        }
+    // Shared by the seeds, the fitness of a chromosome doesn't depend on the seed
+    std::unique_ptr<FitnessCache> fitness_cache;
+    if(config.fitness_cache_mb > 0){
+        fitness_cache = std::make_unique<FitnessCache>(data.getNumTasks(), static_cast<size_t>(config.fitness_cache_mb) << 20);
+    }
 
-        for(int generation = 0; generation < generation_size; ++generation){
-            
-            // Autoadapation logic
-            if(gens_no_improve > 5){
-                // Exploration
-                params.crossover_prob = 60;
-                params.mutation_prob = 20; 
-            }else if(gens_no_improve == 0){
-                // Exploitation
-                params.crossover_prob = 90;
-                params.mutation_prob = 1;
-            }else{
-                // Balanced
-                params.crossover_prob = 80;
-                params.mutation_prob = 10;
+    ThreadPool pool(config.num_threads);
+    std::mutex console_mutex;
+    auto instance_start = std::chrono::steady_clock::now();
+    std::vector<SeedProfile> seed_profiles;
+
+    // Seed loop, every seed is independent from the others
+    SeedOrderedWriter indicators(indicators_file, config.seeds.size());
+    std::vector<std::future<SeedOutput>> seed_outputs;
+    for(size_t seed_index = 0; seed_index < config.seeds.size(); ++seed_index){
+        int seed = config.seeds[seed_index];
+        seed_outputs.push_back(pool.submit([&, seed, seed_index](){
+            {
+                std::lock_guard<std::mutex> lock(console_mutex);
+                std::cout << "[" << instance_name << "] Seed: " << seed << "...\n";
             }
+            // Seeds and the steps inside their generations share the workers
+            return runSeed(data, plan, seed, config, reference_point, fitness_cache.get(), pool, indicators, seed_index);
+        }));
+    }
 
-            // Offsprings. Sort the current population
-            //* Could be more efficient, but it's late and I'm tired
-            for(const PolicyType& pol : policy_index_map){
-                auto fronts = fastNonDominatedSort(population, pol);
+    // Rows are merged in seed order, same files as a serial run
+    for(auto& seed_output : seed_outputs){
+        SeedOutput output = seed_output.get();
+        {
+            PROFILE_SCOPE(output.profile, Phase::OUTPUT);
+            log_file.write(output.checkpoint_rows);
 
-                for(auto& front : fronts){
-                    std::vector<Individual> temp_front;
-                    for(int idx : front){
-                        temp_front.push_back(population[idx]);
-                    }
-                    calculateCrowdingDistance(temp_front, pol);
+            gantt_exporter.push(std::move(output.gantt));
+        }
+        seed_profiles.push_back(output.profile);
+    }
 
-                    for(size_t i = 0; i < front.size(); ++i){
-                        int original_idx = front[i];
-                        float new_cd = temp_front[i].crowding_distance.getValue(pol);
-                        population[original_idx].crowding_distance.setValue(pol, new_cd);
-                    }
-                }
-            }
+    if(!log_file.close()) std::cerr << "Error: Could'nt write the stats file: " << log_filepath << std::endl;
+    if(!indicators_file.close()) std::cerr << "Error: Could'nt write the indicators file: " << indicators_filepath << std::endl;
 
-            std::vector<Individual> offspring_population;
-            while(offspring_population.size() < population_size){
-                // Crossover
-                int idx1 = random_parent(gen);
-                int idx2 = random_parent(gen);
-                
-                Individual& parent1 = population.at(idx1);
-                Individual& parent2 = population.at(idx2);
-
-                auto [child1, child2] = crossover(parent1, parent2, policies_order, gen, params.crossover_prob);
-
-                // Mutation with adaptive probability
-                if(prob_gen(gen) < params.mutation_prob){
-                    int type = std::uniform_int_distribution<>(0, 2)(gen);
-                    if(type == 0) equitativeExchange(child1, gen);
-                    else if(type == 1) interChrome(child1, gen);
-                    else circular(child1, gen);
-                }
-                if(prob_gen(gen) < params.mutation_prob){
-                    int type = std::uniform_int_distribution<>(0, 2)(gen);
-                    if(type == 0) equitativeExchange(child2, gen);
-                    else if(type == 1) interChrome(child2, gen);
-                    else circular(child2, gen);
-                }
+    gantt_exporter.finish();
+    for(size_t i = 0; i < gantt_exporter.profiles().size(); ++i) mergeProfile(seed_profiles[i], gantt_exporter.profiles()[i]);
 
-                offspring_population.push_back(child1);
-                if(offspring_population.size() < population_size){
-                    offspring_population.push_back(child2);
-                }
-            }
-            
-            // Evaluation offspring
-            float current_gen_best = 1e9;
-            for(const auto& policy : policy_index_map){
-                PolicyType pol = policy;
-                for(Individual& child : offspring_population){
-                    auto [makespan, _] = totalTime(data, child, pol, policies_order);
-                    float energy   = totalEnergy(data, child, pol, policies_order);
-                    
-                    child.time_fitness.setValue(policy, makespan);
-                    child.energy_fitness.setValue(policy, energy);
-                    
-                    if(makespan < current_gen_best) current_gen_best = makespan;
-                }
-            }
-            
-            // Check Improvement
-            if(current_gen_best < global_best_makespan){
-                global_best_makespan = current_gen_best;
-                gens_no_improve = 0;
-            } else {
-                gens_no_improve++;
-            }
+    double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - instance_start).count();
+    if(profilingEnabled()){
+        uint64_t evaluations = 0;
+        for(const SeedProfile& profile : seed_profiles) evaluations += profile.evaluations;
+        std::cout << "[" << instance_name << "] " << evaluations << " evaluations in " << wall_seconds << " s ("
+                  << (wall_seconds > 0 ? evaluations / wall_seconds : 0.0) << " evals/s)\n";
+        if(config.write_profile) writeProfile(base_path + "/profile.csv", seed_profiles, wall_seconds);
+    }
 
-            // Merge & Survival
-            std::vector<Individual> combined_population = population;
-            combined_population.insert(combined_population.end(), offspring_population.begin(), offspring_population.end());
-
-            // Sort mixed population
-            for(const PolicyType& pol : policy_index_map){
-                auto fronts = fastNonDominatedSort(combined_population, pol);
-                for(auto& front : fronts){
-                    std::vector<Individual> temp_front;
-                    for(int idx : front){
-                        temp_front.push_back(combined_population[idx]);
-                    }
-                    calculateCrowdingDistance(temp_front, pol);
-                    for(size_t i = 0; i < front.size(); ++i){
-                        int original_idx = front[i];
-                        float new_cd = temp_front[i].crowding_distance.getValue(pol);
-                        combined_population[original_idx].crowding_distance.setValue(pol, new_cd);
-                    }
-                }
-            }
+    if(fitness_cache){
+        FitnessCache::Stats stats = fitness_cache->stats();
+        std::cout << "[" << instance_name << "] Fitness cache: " << stats.hits << " hits / " << stats.lookups
+                  << " lookups (" << 100.0 * stats.hitRate() << "%), " << stats.inserts << " inserts, "
+                  << stats.evictions << " evictions, " << fitness_cache->capacity() << " entries\n";
+    }
 
-            std::vector<Individual> next_population;
-            while(next_population.size() < population_size){
-                Individual survivor = tournamentSelection(combined_population, gen);
-                next_population.push_back(survivor);
-            }            
-            population = next_population;
-
-            // Save stats every 20th gen AND INCLUDE ADAPTIVE PARAMS
-            if((generation + 1) % 20 == 0 || generation == 0){
-                for(const auto& policy : policy_index_map){
-                    auto fronts_indices = fastNonDominatedSort(population, policy);
-                    if(fronts_indices.empty()) continue;
-
-                    // The first front is saved
-                    const std::vector<int>& pareto_indices = fronts_indices[0];
-                    if(pareto_indices.empty()) continue;
-
-                    for(int idx : pareto_indices){
-                        const Individual& ind = population[idx];
-                        log_file << seed << ","
-                                 << (generation + 1) << ","
-                                 << policyToString(policy) << ","
-                                 << 1 << "," // Rank 1
-                                 << ind.time_fitness.getValue(policy) << ","
-                                 << ind.energy_fitness.getValue(policy) << ","
-                                 << params.crossover_prob << "," 
-                                 << params.mutation_prob << "\n";
-                    }
-                }
-            }
-        } // End Gen Loop
-
-        // Save Gantt
-        for(auto policy : policy_index_map){
-            std::string policy_name = policyToString(policy);
-            auto final_front = fastNonDominatedSort(population, policy);
-
-            if(final_front.empty()) continue;
-
-            const std::vector<int>& pareto_indices = final_front[0];
-            std::vector<Individual> pareto_front_copies;
-            for(int idx : pareto_indices) pareto_front_copies.push_back(population[idx]);
-
-            calculateCrowdingDistance(pareto_front_copies, policy);
-            // Sort by time to be consistent
-             std::sort(pareto_front_copies.begin(), pareto_front_copies.end(), [&](const Individual& a, const Individual& b){
-                return a.time_fitness.getValue(policy) < b.time_fitness.getValue(policy);
-            });
-
-            int sol_idx = 1;
-            for(Individual& ind : pareto_front_copies){
-                auto [makespan, gantt] = totalTime(data, ind, policy, policies_order); 
-                
-                std::string gantt_filename = base_path + "/" +
-                                             policy_name +
-                                             "/seed_" + std::to_string(seed) +
-                                             "_solution_" + std::to_string(sol_idx++) + 
-                                             ".txt";
-                saveGanttToFile(gantt_filename, gantt);
-            }
-        }
-    } // End Seed Loop
-    log_file.close();
     std::cout << "[" << instance_name << "] DONE.\n";
-}
\ No newline at end of file
+}
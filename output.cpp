@@ -0,0 +1,142 @@
+#include "headers/output.h"
+
+#include <charconv>
+
+void CsvBuffer::separator(){
+    if(!row_start) text.push_back(delimiter);
+    row_start = false;
+}
+
+CsvBuffer& CsvBuffer::add(int value){
+    separator();
+    char digits[16];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    text.append(digits, result.ptr);
+    return *this;
+}
+
+CsvBuffer& CsvBuffer::add(uint64_t value){
+    separator();
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    text.append(digits, result.ptr);
+    return *this;
+}
+
+CsvBuffer& CsvBuffer::add(float value){
+    separator();
+    char digits[32];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 6);
+    text.append(digits, result.ptr);
+    return *this;
+}
+
+CsvBuffer& CsvBuffer::add(double value){
+    separator();
+    char digits[32];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 7);
+    text.append(digits, result.ptr);
+    return *this;
+}
+
+CsvBuffer& CsvBuffer::add(std::string_view value){
+    separator();
+    text.append(value);
+    return *this;
+}
+
+void CsvBuffer::endRow(){
+    text.push_back('\n');
+    row_start = true;
+}
+
+void CsvBuffer::append(std::string_view raw){
+    text.append(raw);
+}
+
+void CsvBuffer::clear(){
+    text.clear();
+    row_start = true;
+}
+
+BufferedFile::BufferedFile(size_t capacity) : buffer(capacity) {}
+
+BufferedFile::~BufferedFile(){
+    close();
+}
+
+bool BufferedFile::open(const std::string& path){
+    close();
+    file = std::fopen(path.c_str(), "wb");
+    used = 0;
+    written = 0;
+    failed = false;
+    return file != nullptr;
+}
+
+bool BufferedFile::isOpen() const{
+    return file != nullptr;
+}
+
+bool BufferedFile::close(){
+    if(!file) return !failed;
+    flush();
+    if(std::fclose(file) != 0) failed = true;
+    file = nullptr;
+    return !failed;
+}
+
+void BufferedFile::write(std::string_view data){
+    written += data.size();
+    // Big blocks skip the buffer
+    if(data.size() >= buffer.size()){
+        flush();
+        if(file && std::fwrite(data.data(), 1, data.size(), file) != data.size()) failed = true;
+        return;
+    }
+    if(used + data.size() > buffer.size()) flush();
+    data.copy(buffer.data() + used, data.size());
+    used += data.size();
+}
+
+void BufferedFile::flush(){
+    if(file && used > 0 && std::fwrite(buffer.data(), 1, used, file) != used) failed = true;
+    used = 0;
+}
+
+void BufferedFile::sync(){
+    flush();
+    if(file && std::fflush(file) != 0) failed = true;
+}
+
+uint64_t BufferedFile::bytesWritten() const{
+    return written;
+}
+
+SeedOrderedWriter::SeedOrderedWriter(BufferedFile& file, size_t num_seeds)
+    : file(file), pending(num_seeds), finished(num_seeds, 0){}
+
+void SeedOrderedWriter::write(size_t seed_index, std::string_view rows){
+    std::lock_guard<std::mutex> lock(mutex);
+    if(seed_index == head){
+        file.write(rows);
+        file.sync();
+    }else{
+        pending[seed_index].append(rows);
+    }
+}
+
+void SeedOrderedWriter::finish(size_t seed_index){
+    std::lock_guard<std::mutex> lock(mutex);
+    finished[seed_index] = 1;
+    bool written = false;
+    while(head < finished.size() && finished[head]){
+        ++head;
+        if(head < pending.size() && !pending[head].empty()){
+            file.write(pending[head]);
+            std::string().swap(pending[head]);
+            written = true;
+        }
+    }
+    if(written) file.sync();
+}
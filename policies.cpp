@@ -1,4 +1,5 @@
 #include "headers/policies.h"
+#include "headers/individual.h"
 
 #include <algorithm>
 #include <cfloat>
@@ -11,13 +12,16 @@ size_t max_cols(const vvi& jobs){
 }
 
 // @brief It returns min, max and avg as stats for the policies
-std::vector<JobStats> stats(const vvi& jobs, const vvf& operations){
-    std::vector<JobStats> full_stats(operations.size());
+// row_at(i) gives the [begin, end) range of the values of operation i
+template <typename RowAt>
+std::vector<JobStats> stats(const vvi& jobs, int num_operations, RowAt row_at){
+    std::vector<JobStats> full_stats(num_operations);
     std::vector<JobStats> op_stats(jobs.size());
 
-    for(int i = 0; i < operations.size(); ++i){
-        auto [min, max] = std::minmax_element(operations[i].begin(), operations[i].end());
-        float avg = std::accumulate(operations[i].begin(), operations[i].end(), 0.0f) / operations[i].size();
+    for(int i = 0; i < num_operations; ++i){
+        auto [begin, end] = row_at(i);
+        auto [min, max] = std::minmax_element(begin, end);
+        float avg = std::accumulate(begin, end, 0.0f) / (end - begin);
 
         full_stats[i].min_time = *min;
         full_stats[i].max_time = *max;
@@ -41,6 +45,24 @@ std::vector<JobStats> stats(const vvi& jobs, const vvf& operations){
     return op_stats;
 }
 
+std::vector<JobStats> stats(const vvi& jobs, const vvf& operations){
+    return stats(jobs, operations.size(), [&operations](int i){
+        return std::make_pair(operations[i].data(), operations[i].data() + operations[i].size());
+    });
+}
+
+std::vector<JobStats> timeStats(const vvi& jobs, const Data& data){
+    return stats(jobs, data.getNumRows(), [&data](int i){
+        return std::make_pair(data.timeRow(i), data.timeRow(i) + data.getNumMachines());
+    });
+}
+
+std::vector<JobStats> energyStats(const vvi& jobs, const Data& data){
+    return stats(jobs, data.getNumRows(), [&data](int i){
+        return std::make_pair(data.energyRow(i), data.energyRow(i) + data.getNumMachines());
+    });
+}
+
 vec_op FIFO(const int& tasks, const vvi& jobs){
     int idx = 0;
     vec_op fifo(tasks);
@@ -54,10 +76,9 @@ vec_op FIFO(const int& tasks, const vvi& jobs){
     return fifo;
 }
 
-vec_op LTP(const int& tasks, const vvi& jobs, const vvf& operations){
+static vec_op LTPFromStats(const int& tasks, const vvi& jobs, const std::vector<JobStats>& time){
     int idx = 0;
     vec_op ltp(tasks);
-    std::vector<JobStats> time = stats(jobs, operations);
     std::vector<int> index(jobs.size());
     std::iota(index.begin(), index.end(), 0);
 
@@ -74,10 +95,9 @@ vec_op LTP(const int& tasks, const vvi& jobs, const vvf& operations){
     return ltp;
 }
 
-vec_op STP(const int& tasks, const vvi& jobs, const vvf& operations){
+static vec_op STPFromStats(const int& tasks, const vvi& jobs, const std::vector<JobStats>& time){
     int idx = 0;
     vec_op stp(tasks);
-    std::vector<JobStats> time = stats(jobs, operations);
     std::vector<int> index(jobs.size());
     std::iota(index.begin(), index.end(), 0);
 
@@ -110,11 +130,10 @@ vec_op RR_FIFO(const int& tasks, const vvi& jobs){
     return rr_fifo;
 }
 
-vec_op RR_LTP(const int& tasks, const vvi& jobs, const vvf& operations){
+static vec_op RR_LTPFromStats(const int& tasks, const vvi& jobs, const std::vector<JobStats>& time){
     int idx = 0;
     vec_op rr_ltp(tasks);
     size_t cols = max_cols(jobs);
-    std::vector<JobStats> time = stats(jobs, operations);
     std::vector<int> index(jobs.size());
     std::iota(index.begin(), index.end(), 0);
 
@@ -133,11 +152,10 @@ vec_op RR_LTP(const int& tasks, const vvi& jobs, const vvf& operations){
     return rr_ltp;
 }
 
-vec_op RR_ECA(const int& tasks, const vvi& jobs, const vvf& operations){
+static vec_op RR_ECAFromStats(const int& tasks, const vvi& jobs, const std::vector<JobStats>& energy){
     int idx = 0;
     vec_op rr_eca(tasks);
     size_t cols = max_cols(jobs);
-    std::vector<JobStats> energy = stats(jobs, operations);
     std::vector<int> index(jobs.size());
     std::iota(index.begin(), index.end(), 0);
 
@@ -154,4 +172,36 @@ vec_op RR_ECA(const int& tasks, const vvi& jobs, const vvf& operations){
     }
 
     return rr_eca;
+}
+
+vec_op LTP(const int& tasks, const vvi& jobs, const vvf& time){
+    return LTPFromStats(tasks, jobs, stats(jobs, time));
+}
+
+vec_op STP(const int& tasks, const vvi& jobs, const vvf& time){
+    return STPFromStats(tasks, jobs, stats(jobs, time));
+}
+
+vec_op RR_LTP(const int& tasks, const vvi& jobs, const vvf& time){
+    return RR_LTPFromStats(tasks, jobs, stats(jobs, time));
+}
+
+vec_op RR_ECA(const int& tasks, const vvi& jobs, const vvf& energy){
+    return RR_ECAFromStats(tasks, jobs, stats(jobs, energy));
+}
+
+vec_op LTP(const int& tasks, const vvi& jobs, const Data& data){
+    return LTPFromStats(tasks, jobs, timeStats(jobs, data));
+}
+
+vec_op STP(const int& tasks, const vvi& jobs, const Data& data){
+    return STPFromStats(tasks, jobs, timeStats(jobs, data));
+}
+
+vec_op RR_LTP(const int& tasks, const vvi& jobs, const Data& data){
+    return RR_LTPFromStats(tasks, jobs, timeStats(jobs, data));
+}
+
+vec_op RR_ECA(const int& tasks, const vvi& jobs, const Data& data){
+    return RR_ECAFromStats(tasks, jobs, energyStats(jobs, data));
 }
\ No newline at end of file
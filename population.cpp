@@ -0,0 +1,98 @@
+#include "headers/population.h"
+
+#include <algorithm>
+
+GeneArena::GeneArena(int gene_length, int max_rows)
+    : gene_length(gene_length), genes(static_cast<size_t>(gene_length) * max_rows), in_use(max_rows, 0){
+    // Lowest rows are handed out first
+    free_rows.reserve(max_rows);
+    for(int r = max_rows - 1; r >= 0; --r) free_rows.push_back(r);
+}
+
+int GeneArena::geneLength() const{
+    return gene_length;
+}
+
+int GeneArena::acquire(){
+    // The arena is sized for the worst case of the GA loop, running out is a bug
+    int r = free_rows.back();
+    free_rows.pop_back();
+    in_use[r] = 1;
+    return r;
+}
+
+void GeneArena::acquireIndividual(Population& population, int ind){
+    for(int p = 0; p < NUM_POLICIES; ++p) population.row(static_cast<PolicyType>(p), ind) = acquire();
+}
+
+int* GeneArena::row(int r){
+    return genes.data() + static_cast<size_t>(r) * gene_length;
+}
+
+const int* GeneArena::row(int r) const{
+    return genes.data() + static_cast<size_t>(r) * gene_length;
+}
+
+void GeneArena::collect(const Population& keep){
+    std::fill(in_use.begin(), in_use.end(), 0);
+    for(int p = 0; p < NUM_POLICIES; ++p){
+        PolicyType policy = static_cast<PolicyType>(p);
+        for(int i = 0; i < keep.size(); ++i) in_use[keep.row(policy, i)] = 1;
+    }
+
+    free_rows.clear();
+    for(int r = static_cast<int>(in_use.size()) - 1; r >= 0; --r){
+        if(!in_use[r]) free_rows.push_back(r);
+    }
+}
+
+Population::Population(int capacity)
+    : capacity(capacity), count(0),
+      rows(NUM_POLICIES * capacity, -1),
+      time_fitness(NUM_POLICIES * capacity, 0.0f),
+      energy_fitness(NUM_POLICIES * capacity, 0.0f),
+      crowding_distance(NUM_POLICIES * capacity, 0.0f),
+      rank(NUM_POLICIES * capacity, 0) {}
+
+int Population::size() const{
+    return count;
+}
+
+void Population::resize(int n){
+    count = std::min(n, capacity);
+}
+
+void Population::copyPolicy(PolicyType policy, int ind, const Population& src, int src_ind){
+    int dst = index(policy, ind);
+    int from = src.index(policy, src_ind);
+
+    rows[dst]              = src.rows[from];
+    time_fitness[dst]      = src.time_fitness[from];
+    energy_fitness[dst]    = src.energy_fitness[from];
+    crowding_distance[dst] = src.crowding_distance[from];
+    rank[dst]              = src.rank[from];
+}
+
+void Population::assignMerged(const Population& a, const Population& b){
+    resize(a.size() + b.size());
+    for(int p = 0; p < NUM_POLICIES; ++p){
+        PolicyType policy = static_cast<PolicyType>(p);
+        for(int i = 0; i < a.size(); ++i) copyPolicy(policy, i, a, i);
+        for(int i = 0; i < b.size(); ++i) copyPolicy(policy, a.size() + i, b, i);
+    }
+}
+
+Individual Population::extract(const GeneArena& arena, int ind) const{
+    Individual individual;
+    forEachPolicy([&](auto policy_constant){
+        constexpr PolicyType policy = decltype(policy_constant)::value;
+        const int* genes = arena.row(row(policy, ind));
+
+        individual.chromosome.get<policy>().assign(genes, genes + arena.geneLength());
+        individual.time_fitness.get<policy>()      = time_fitness[index(policy, ind)];
+        individual.energy_fitness.get<policy>()    = energy_fitness[index(policy, ind)];
+        individual.crowding_distance.get<policy>() = crowding_distance[index(policy, ind)];
+        individual.rank.get<policy>()              = rank[index(policy, ind)];
+    });
+    return individual;
+}
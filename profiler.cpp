@@ -0,0 +1,62 @@
+#include "headers/profiler.h"
+#include "headers/output.h"
+
+#include <iostream>
+
+const char* phaseName(Phase phase){
+    switch(phase){
+        case Phase::INITIALIZATION: return "Initialization";
+        case Phase::EVALUATION:     return "Evaluation";
+        case Phase::SORTING:        return "Sorting";
+        case Phase::CROWDING:       return "Crowding";
+        case Phase::VARIATION:      return "Variation";
+        case Phase::SELECTION:      return "Selection";
+        case Phase::CHECKPOINT:     return "Checkpoint";
+        case Phase::GANTT:          return "Gantt";
+        case Phase::OUTPUT:         return "Output";
+        default:                    return "Unknown";
+    }
+}
+
+void mergeProfile(SeedProfile& into, const SeedProfile& from){
+    for(int phase = 0; phase < NUM_PHASES; ++phase){
+        into.phase_ns[phase]    += from.phase_ns[phase];
+        into.phase_calls[phase] += from.phase_calls[phase];
+    }
+    into.evaluations += from.evaluations;
+}
+
+bool writeProfile(const std::string& path, const std::vector<SeedProfile>& profiles, double wall_seconds){
+    CsvBuffer csv;
+    csv.add("Seed").add("Total_s").add("Evaluations").add("Evals_per_s");
+    for(int p = 0; p < NUM_PHASES; ++p) csv.add(std::string(phaseName(static_cast<Phase>(p))) + "_s");
+    csv.endRow();
+
+    SeedProfile total;
+    for(const SeedProfile& profile : profiles){
+        csv.add(profile.seed)
+           .add(profile.total_ns * 1e-9)
+           .add(profile.evaluations)
+           .add(profile.evaluationsPerSecond());
+        for(int p = 0; p < NUM_PHASES; ++p) csv.add(profile.seconds(static_cast<Phase>(p)));
+        csv.endRow();
+
+        mergeProfile(total, profile);
+    }
+
+    // Seeds overlap when they run in parallel, the rate of the instance uses the wall time
+    csv.add("all")
+       .add(wall_seconds)
+       .add(total.evaluations)
+       .add(wall_seconds > 0 ? total.evaluations / wall_seconds : 0.0);
+    for(int p = 0; p < NUM_PHASES; ++p) csv.add(total.seconds(static_cast<Phase>(p)));
+    csv.endRow();
+
+    BufferedFile file(0);
+    if(!file.open(path)){
+        std::cerr << "Error: Could'nt open the profile file: " << path << std::endl;
+        return false;
+    }
+    file.write(csv.str());
+    return file.close();
+}
@@ -1,5 +1,7 @@
 #include "headers/read_test.h"
+#include "headers/mapped_file.h"
 
+#include <charconv>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -109,4 +111,134 @@ std::vector<std::vector<int>> loadWork(std::ifstream& f){
     }
 
     return work;
-}
\ No newline at end of file
+}
+
+//* Fast loader *//
+
+namespace{
+
+// Position inside the mapped text, lines and columns start at 1
+class TextCursor{
+private:
+    const char* current;
+    const char* end;
+    const char* line_start;
+    int line;
+
+public:
+    TextCursor(const char* begin, const char* end) : current(begin), end(end), line_start(begin), line(1) {}
+
+    int lineNumber() const{ return line; }
+    int column() const{ return static_cast<int>(current - line_start) + 1; }
+    bool atEnd() const{ return current >= end; }
+
+    // Spaces, tabs and '\r' inside the current line
+    void skipBlanks(){
+        while(current < end && (*current == ' ' || *current == '\t' || *current == '\r')) ++current;
+    }
+
+    bool atEndOfLine(){
+        skipBlanks();
+        return current >= end || *current == '\n';
+    }
+
+    // Moves to the next line, false if there's something else left in this one
+    bool nextLine(){
+        if(!atEndOfLine()) return false;
+        if(current < end){
+            ++current;
+            ++line;
+            line_start = current;
+        }
+        return true;
+    }
+
+    template <typename T>
+    bool parse(T& value){
+        skipBlanks();
+        if(current >= end || *current == '\n') return false;
+        auto [ptr, ec] = std::from_chars(current, end, value);
+        if(ec != std::errc() || (ptr < end && *ptr != ' ' && *ptr != '\t' && *ptr != '\r' && *ptr != '\n')) return false;
+        current = ptr;
+        return true;
+    }
+};
+
+bool reportError(const std::string& path, int line, int column, const std::string& message){
+    std::cerr << path << ":" << line << ":" << column << ": " << message << "\n";
+    return false;
+}
+
+bool reportError(const std::string& path, const TextCursor& cursor, const std::string& message){
+    return reportError(path, cursor.lineNumber(), cursor.column(), message);
+}
+
+// "operations machines" line
+bool parseShape(const std::string& path, TextCursor& cursor, int& rows, int& machines){
+    if(!cursor.parse(rows) || !cursor.parse(machines) || rows < 1 || machines < 1){
+        return reportError(path, cursor, "expected the number of operations and machines");
+    }
+    if(!cursor.nextLine()) return reportError(path, cursor, "expected only two values");
+    return true;
+}
+
+bool parseTable(const std::string& path, TextCursor& cursor, int rows, int machines, Data& data, bool energy){
+    for(int op = 0; op < rows; ++op){
+        float* row = energy ? data.mutableEnergyRow(op) : data.mutableTimeRow(op);
+        for(int machine = 0; machine < machines; ++machine){
+            if(!cursor.parse(row[machine])){
+                return reportError(path, cursor, "expected " + std::to_string(machines) + " numbers in this row");
+            }
+        }
+        if(!cursor.nextLine()) return reportError(path, cursor, "more than " + std::to_string(machines) + " values in this row");
+    }
+    return true;
+}
+
+} // namespace
+
+bool loadInstanceFile(const std::string& path, Data& data, std::vector<std::vector<int>>& jobs){
+    MappedFile file;
+    if(!file.open(path)){
+        std::cerr << "Test case file not found: " << path << "\n";
+        return false;
+    }
+    TextCursor cursor(file.data(), file.data() + file.size());
+
+    // Time table
+    int rows = 0, machines = 0;
+    if(!parseShape(path, cursor, rows, machines)) return false;
+    data.allocateTables(rows, machines);
+    if(!parseTable(path, cursor, rows, machines, data, false)) return false;
+
+    // Energy table, same size
+    int energy_rows = 0, energy_machines = 0;
+    if(!parseShape(path, cursor, energy_rows, energy_machines)) return false;
+    if(energy_rows != rows || energy_machines != machines){
+        return reportError(path, cursor, "time and energy tables don't match in size");
+    }
+    if(!parseTable(path, cursor, rows, machines, data, true)) return false;
+
+    // Jobs
+    int num_jobs = 0;
+    if(!cursor.parse(num_jobs) || num_jobs < 1) return reportError(path, cursor, "expected the number of jobs");
+    if(!cursor.nextLine()) return reportError(path, cursor, "there's more than 1 value, expected the number of jobs");
+
+    jobs.assign(num_jobs, {});
+    for(int job = 0; job < num_jobs; ++job){
+        if(cursor.atEnd()) return reportError(path, cursor, "expected " + std::to_string(num_jobs) + " jobs");
+        while(!cursor.atEndOfLine()){
+            int op = 0;
+            int column = cursor.column(); // atEndOfLine() already skipped the blanks
+            if(!cursor.parse(op)) return reportError(path, cursor, "expected an operation number");
+            if(op < 1 || op > rows){
+                return reportError(path, cursor.lineNumber(), column, "operation out of range (1.." + std::to_string(rows) + ")");
+            }
+            jobs[job].push_back(op);
+        }
+        cursor.nextLine();
+    }
+
+    data.finishLoading(jobs);
+    return true;
+}
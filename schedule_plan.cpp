@@ -0,0 +1,42 @@
+#include "headers/schedule_plan.h"
+
+#include <algorithm>
+
+SchedulePlan::SchedulePlan(const Data& data, const std::unordered_map<PolicyType, vec_op>& policies_order,
+size_t max_cost_bytes){
+    const int num_ops      = data.getNumTasks();
+    const int num_machines = data.getNumMachines();
+
+    size_t ordered_bytes = static_cast<size_t>(NUM_POLICIES) * num_ops * num_machines * sizeof(TimeEnergy);
+    bool ordered = ordered_bytes <= max_cost_bytes;
+    if(ordered) ordered_costs.resize(static_cast<size_t>(NUM_POLICIES) * num_ops * num_machines);
+
+    for(int p = 0; p < NUM_POLICIES; ++p){
+        const vec_op& order = policies_order.at(static_cast<PolicyType>(p));
+        PolicyPlan& plan = plans[p];
+        plan.num_ops      = num_ops;
+        plan.num_jobs     = data.getNumJobs();
+        plan.num_machines = num_machines;
+
+        plan.jobs.resize(num_ops);
+        plan.operations.resize(num_ops);
+        plan.cost_rows.resize(num_ops);
+        for(int priority = 0; priority < num_ops; ++priority){
+            plan.jobs[priority]       = order[priority].job_idx;
+            plan.operations[priority] = order[priority].op_idx;
+            plan.cost_rows[priority]  = ordered ? priority : order[priority].op_idx;
+        }
+
+        if(!ordered){
+            plan.costs = data.timeEnergyRow(0);
+            continue;
+        }
+
+        TimeEnergy* costs = ordered_costs.data() + static_cast<size_t>(p) * num_ops * num_machines;
+        for(int priority = 0; priority < num_ops; ++priority){
+            const TimeEnergy* row = data.timeEnergyRow(order[priority].op_idx);
+            std::copy(row, row + num_machines, costs + static_cast<size_t>(priority) * num_machines);
+        }
+        plan.costs = costs;
+    }
+}
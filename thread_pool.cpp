@@ -0,0 +1,201 @@
+#include "headers/thread_pool.h"
+
+#include <algorithm>
+
+// Worker of the running thread, -1 outside every pool
+static thread_local const ThreadPool* current_pool = nullptr;
+static thread_local int current_worker = -1;
+
+void TaskQueue::pushBack(std::function<void()> task){
+    if(count == slots.size()){
+        std::vector<std::function<void()>> grown(std::max<size_t>(16, 2 * slots.size()));
+        for(size_t i = 0; i < count; ++i) grown[i] = std::move(slots[(head + i) % slots.size()]);
+        slots.swap(grown);
+        head = 0;
+    }
+    slots[(head + count) % slots.size()] = std::move(task);
+    ++count;
+}
+
+std::function<void()> TaskQueue::popBack(){
+    --count;
+    return std::move(slots[(head + count) % slots.size()]);
+}
+
+std::function<void()> TaskQueue::popFront(){
+    std::function<void()> task = std::move(slots[head]);
+    head = (head + 1) % slots.size();
+    --count;
+    return task;
+}
+
+// The pool outlives every loop: it waits for its helpers before its workers leave
+struct ThreadPool::Loop{
+    LoopBody body;
+    void* context;
+    int count;
+    std::atomic<int> next{0};
+    std::atomic<int> references{0}; // The caller and every helper submitted
+
+    // Helpers that start once the loop is over return without touching body
+    std::mutex mutex;
+    std::condition_variable done;
+    int active      = 0;
+    int lanes_taken = 0;
+    bool finished   = false;
+};
+
+ThreadPool::ThreadPool(unsigned int num_threads) : stopping(false){
+    if(num_threads == 0) num_threads = std::thread::hardware_concurrency();
+    if(num_threads == 0) num_threads = 1; // hardware_concurrency can't tell
+
+    for(unsigned int i = 0; i < num_threads; ++i) local_queues.push_back(std::make_unique<WorkerQueue>());
+
+    workers.reserve(num_threads);
+    for(unsigned int i = 0; i < num_threads; ++i){
+        workers.emplace_back(&ThreadPool::workerLoop, this, static_cast<int>(i));
+    }
+}
+
+ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    // Pending tasks are still drained before the workers leave
+    for(std::thread& worker : workers) worker.join();
+}
+
+unsigned int ThreadPool::size() const{
+    return workers.size();
+}
+
+void ThreadPool::push(std::function<void()> task){
+    if(current_pool == this){
+        WorkerQueue& queue = *local_queues[current_worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.pushBack(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if(current_pool != this) shared_tasks.pushBack(std::move(task));
+        ++pending;
+    }
+    condition.notify_one();
+}
+
+// Own queue (newest first), then the shared queue, then the oldest task of another worker
+bool ThreadPool::tryPop(int worker, std::function<void()>& task){
+    {
+        WorkerQueue& queue = *local_queues[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(!queue.tasks.empty()){
+            task = queue.tasks.popBack();
+            return true;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if(!shared_tasks.empty()){
+            task = shared_tasks.popFront();
+            return true;
+        }
+    }
+    int num_workers = local_queues.size();
+    for(int offset = 1; offset < num_workers; ++offset){
+        WorkerQueue& victim = *local_queues[(worker + offset) % num_workers];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if(!victim.tasks.empty()){
+            task = victim.tasks.popFront();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(int worker){
+    current_pool = this;
+    current_worker = worker;
+
+    while(true){
+        std::function<void()> task;
+        if(tryPop(worker, task)){
+            --pending;
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        condition.wait(lock, [this]{ return stopping || pending > 0; });
+        if(stopping && pending == 0) return;
+    }
+}
+
+ThreadPool::Loop* ThreadPool::acquireLoop(){
+    std::lock_guard<std::mutex> lock(loop_mutex);
+    if(free_loops.empty()){
+        loops.push_back(std::make_unique<Loop>());
+        free_loops.reserve(loops.size());
+        return loops.back().get();
+    }
+    Loop* loop = free_loops.back();
+    free_loops.pop_back();
+    return loop;
+}
+
+void ThreadPool::releaseLoop(Loop* loop){
+    if(--loop->references > 0) return;
+    std::lock_guard<std::mutex> lock(loop_mutex);
+    free_loops.push_back(loop);
+}
+
+void ThreadPool::runLoop(Loop* loop, int lane){
+    for(int i = loop->next++; i < loop->count; i = loop->next++) loop->body(loop->context, i, lane);
+}
+
+void ThreadPool::helpLoop(Loop* loop){
+    int lane = -1;
+    {
+        std::lock_guard<std::mutex> lock(loop->mutex);
+        if(!loop->finished){
+            ++loop->active;
+            lane = ++loop->lanes_taken;
+        }
+    }
+    if(lane > 0){
+        runLoop(loop, lane);
+        std::lock_guard<std::mutex> lock(loop->mutex);
+        if(--loop->active == 0) loop->done.notify_all();
+    }
+    releaseLoop(loop);
+}
+
+void ThreadPool::parallelFor(int count, int max_lanes, LoopBody body, void* context){
+    int lanes = std::min({max_lanes, count, static_cast<int>(size()) + 1});
+    if(lanes <= 1){
+        for(int i = 0; i < count; ++i) body(context, i, 0);
+        return;
+    }
+
+    Loop* loop = acquireLoop();
+    loop->body        = body;
+    loop->context     = context;
+    loop->count       = count;
+    loop->next        = 0;
+    loop->references  = lanes;
+    loop->active      = 0;
+    loop->lanes_taken = 0;
+    loop->finished    = false;
+
+    // Two pointers, std::function keeps them without allocating
+    for(int helper = 1; helper < lanes; ++helper) push([this, loop](){ helpLoop(loop); });
+
+    runLoop(loop, 0);
+    {
+        std::unique_lock<std::mutex> lock(loop->mutex);
+        loop->done.wait(lock, [loop]{ return loop->active == 0; });
+        loop->finished = true;
+    }
+    releaseLoop(loop);
+}